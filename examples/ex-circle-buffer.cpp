@@ -3,6 +3,7 @@
 //
 
 #include <cassert>
+#include <vector>
 
 #include "circle-buffer.h"
 #include "event.h"
@@ -16,11 +17,28 @@ auto main() -> int
 
 	CircleBuffer<Event, std::uint32_t> event_queue(4);
 
-	event_queue.post(&event_1);
+	event_queue.post(event_1);
+	event_queue.emplace(USER_SIG);
 
-	const Event * event_ret = event_queue.get( );
+	Event event_ret(NULL_SIG);
+	bool const got = event_queue.get(event_ret);
 
-	assert(event_ret->signal == event_1.signal);
+	assert(got && event_ret.signal == event_1.signal);
+	assert(event_queue.front()->signal == USER_SIG);
+
+	CircleBuffer<std::uint16_t> samples(8);
+	std::vector<std::uint16_t> const input {1, 2, 3, 4, 5, 6};
+	samples.post(input.begin(), input.end());
+	samples.consume(samples.readable().size());
+
+	// fill the free space in place, wrapping around the end of the storage
+	for (auto span = samples.writable(); !span.empty(); span = samples.writable()) {
+		for (auto &sample : span) {
+			sample = 7;
+		}
+		samples.commit(span.size());
+	}
+	assert(samples.full());
 
 	return 0;
-}
\ No newline at end of file
+}
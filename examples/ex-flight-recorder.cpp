@@ -0,0 +1,88 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "circle-buffer.h"
+#include "flight-recorder.h"
+
+namespace {
+
+constexpr uint64_t kRecords = 2000000;
+
+//! Trace record, all fields derive from its number so that a torn copy is detected
+struct Trace {
+	uint64_t number;
+	uint64_t square;
+	uint64_t inverted;
+};
+
+Trace MakeTrace(uint64_t number) {
+	return Trace{number, number * number, ~number};
+}
+
+} // namespace
+
+auto main() -> int
+{
+	// single threaded: overwrite the oldest value of a full buffer
+	basic::CircleBuffer<int> history(4);
+	int overwritten = 0;
+	for (int i = 1; i <= 6; ++i) {
+		overwritten += history.postOverwrite(i) ? 1 : 0;
+	}
+	int oldest = 0;
+	bool const got = history.get(oldest);
+	assert(2 == overwritten && got && 3 == oldest);
+
+	// shared: snapshots while the writer keeps overwriting
+	using Recorder = basic::FlightRecorder<Trace, 256>;
+	Recorder recorder;
+	std::atomic<bool> done{false};
+
+	std::thread writer([&recorder, &done] {
+		for (uint64_t number = 0; number < kRecords; ++number) {
+			recorder.Record(MakeTrace(number));
+		}
+		done.store(true, std::memory_order_release);
+	});
+
+	uint64_t snapshots = 0;
+	uint64_t gaps = 0;
+	uint64_t errors = 0;
+	std::vector<Recorder::Entry> entries;
+	while (!done.load(std::memory_order_acquire)) {
+		recorder.Snapshot(entries);
+		++snapshots;
+		for (std::size_t i = 0; i < entries.size(); ++i) {
+			Recorder::Entry const &entry = entries[i];
+			Trace const expected = MakeTrace(entry.sequence);
+			bool const intact = entry.value.number == expected.number && entry.value.square == expected.square &&
+			                    entry.value.inverted == expected.inverted;
+			// numbers ascend; a jump is a visible gap of records overwritten during the copy
+			bool const ascending = 0U == i || entry.sequence > entries[i - 1U].sequence;
+			errors += (intact && ascending) ? 0U : 1U;
+			gaps += (0U != i && entry.sequence > entries[i - 1U].sequence + 1U) ? 1U : 0U;
+		}
+	}
+	writer.join();
+
+	// at rest, the snapshot holds exactly the last N records without gaps
+	recorder.Snapshot(entries);
+	bool const complete = Recorder::getCapacity() == entries.size() &&
+	                      kRecords - Recorder::getCapacity() == entries.front().sequence &&
+	                      kRecords - 1U == entries.back().sequence;
+
+	std::cout << "FlightRecorder: " << snapshots << " snapshots, " << gaps << " gaps, " << errors
+	          << " torn or unordered records" << std::endl;
+
+	assert(0U == errors && complete);
+
+	return (2 == overwritten && 3 == oldest && 0U == errors && complete) ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "queue.h"
+#include "lock-free-queue.h"
+
+namespace {
+
+// The goal is 5x the throughput of Queue at 8P/8C on a multi-core machine, which has not been
+// demonstrated yet: on a single cpu the 16 threads time-slice and the speedup stays around 2x (-O2).
+constexpr unsigned int kProducers = 8;
+constexpr unsigned int kConsumers = 8;
+constexpr unsigned int kItemsPerProducer = 200000;
+
+//! Move kItemsPerProducer values per producer through the queue and return items per second
+template<typename QUEUE>
+double Throughput(QUEUE &queue) {
+	std::vector<std::thread> threads;
+	auto const start = std::chrono::steady_clock::now();
+
+	for (unsigned int p = 0; p < kProducers; ++p) {
+		threads.emplace_back([&queue] {
+			for (unsigned int i = 0; i < kItemsPerProducer; ++i) {
+				queue.Push(i);
+			}
+		});
+	}
+	for (unsigned int c = 0; c < kConsumers; ++c) {
+		threads.emplace_back([&queue] {
+			for (unsigned int i = 0; i < kItemsPerProducer * kProducers / kConsumers; ++i) {
+				queue.Pop();
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+	return kProducers * kItemsPerProducer / elapsed.count();
+}
+
+} // namespace
+
+auto main() -> int
+{
+	basic::Queue<unsigned int> queue(1024);
+	basic::LockFreeQueue<unsigned int> lock_free_queue(1024);
+
+	double const mutex_rate = Throughput(queue);
+	double const lock_free_rate = Throughput(lock_free_queue);
+
+	std::cout << kProducers << "P/" << kConsumers << "C Queue:         " << mutex_rate << " items/s" << std::endl;
+	std::cout << kProducers << "P/" << kConsumers << "C LockFreeQueue: " << lock_free_rate << " items/s" << std::endl;
+	std::cout << "speedup: " << lock_free_rate / mutex_rate << "x" << std::endl;
+
+	return 0;
+}
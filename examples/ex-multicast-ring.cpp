@@ -0,0 +1,106 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "multicast-ring.h"
+
+namespace {
+
+constexpr int kProducers = 3;
+constexpr int64_t kEventsPerProducer = 100000;
+constexpr int64_t kEvents = kProducers * kEventsPerProducer;
+
+//! Entry of the ring, written in place by a producer and stamped by the journaller
+struct Event {
+	int64_t sequence = -1;      //!< Sequence the producer wrote the entry for
+	int producer = -1;          //!< Producer index
+	int64_t index = -1;         //!< Running number per producer
+	int64_t journaled = -1;     //!< Sequence the journaller processed
+};
+
+} // namespace
+
+auto main() -> int
+{
+	// a small ring, so the producers wrap around and are gated by the last consumer many times
+	basic::MulticastRing<Event> ring(64, basic::ProducerType::kMulti, basic::WaitStrategy::kSpinPark);
+
+	// A: the journaller stamps every entry
+	int64_t journaled = 0;
+	auto journal = [&journaled](Event &event, int64_t sequence, bool) {
+		event.journaled = sequence;
+		++journaled;
+	};
+	basic::BatchConsumer<Event, decltype(journal)> journaller(ring, ring.newBarrier(), journal);
+
+	// B: the business logic only sees entries A has processed and which were not overwritten yet
+	std::array<int64_t, kProducers> last{-1, -1, -1};
+	int64_t handled = 0;
+	int64_t errors = 0;
+	auto handle = [&](Event &event, int64_t sequence, bool) {
+		bool const intact = sequence == event.sequence && sequence == event.journaled;
+		bool const ordered = event.index == last[event.producer] + 1;
+		errors += (intact && ordered) ? 0 : 1;
+		last[event.producer] = event.index;
+		++handled;
+	};
+	basic::BatchConsumer<Event, decltype(handle)> logic(ring, ring.newBarrier({&journaller.getSequence()}), handle);
+
+	// producers must not overwrite what B has not passed, B is the end of the graph
+	ring.addGatingSequences({&logic.getSequence()});
+
+	std::thread journalThread([&journaller] { journaller.Run(); });
+	std::thread logicThread([&logic] { logic.Run(); });
+
+	std::vector<std::thread> producers;
+	for (int p = 0; p < kProducers; ++p) {
+		producers.emplace_back([&ring, p] {
+			int64_t index = 0;
+			while (index < kEventsPerProducer) {
+				if (0 == p) {
+					// claim a batch and publish it at once
+					int64_t const count = std::min<int64_t>(8, kEventsPerProducer - index);
+					int64_t const high = ring.Claim(count);
+					for (int64_t sequence = high - count + 1; sequence <= high; ++sequence) {
+						ring[sequence] = Event{sequence, p, index++, -1};
+					}
+					ring.Publish(high - count + 1, high);
+				} else {
+					ring.PublishEvent([p, &index](Event &event, int64_t sequence) {
+						event = Event{sequence, p, index++, -1};
+					});
+				}
+			}
+		});
+	}
+	for (auto &producer : producers) {
+		producer.join();
+	}
+
+	// wait until B processed everything, then stop both consumers
+	while (logic.getSequence().get() < kEvents - 1) {
+		std::this_thread::yield();
+	}
+	journaller.Halt();
+	logic.Halt();
+	journalThread.join();
+	logicThread.join();
+
+	std::cout << "MulticastRing: " << kProducers << " producers, " << handled << " events handled after "
+	          << journaled << " journaled, " << errors << " errors" << std::endl;
+
+	bool const complete = kEvents == journaled && kEvents == handled;
+	bool const allProducers = kEventsPerProducer - 1 == last[0] && kEventsPerProducer - 1 == last[1] &&
+	                          kEventsPerProducer - 1 == last[2];
+	assert(complete && allProducers && 0 == errors);
+
+	return (complete && allProducers && 0 == errors) ? 0 : 1;
+}
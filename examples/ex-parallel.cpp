@@ -0,0 +1,100 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.h"
+#include "thread-pool.h"
+
+namespace {
+
+constexpr std::size_t kCount = 1000003;
+
+} // namespace
+
+auto main() -> int
+{
+	basic::ThreadPool pool("ParallelPool", 1024);
+	pool.Start(4);
+
+	std::mt19937_64 random(42);
+	std::vector<uint64_t> input(kCount);
+	for (auto &value : input) {
+		value = random() % 1000000U;
+	}
+
+	// reduce: sum and a non-commutative but associative op against std::reduce / std::accumulate
+	uint64_t const sum = basic::ParallelReduce(pool, input.begin(), input.end(), uint64_t(0));
+	bool const reduced = std::reduce(input.begin(), input.end(), uint64_t(0)) == sum;
+	auto const keepFirst = [](uint64_t lhs, uint64_t) { return lhs; };
+	uint64_t const first = basic::ParallelReduce(pool, input.begin(), input.end(), uint64_t(7), keepFirst);
+	bool const ordered = 7U == first;
+
+	// inclusive scan against std::inclusive_scan
+	std::vector<uint64_t> scanned(kCount);
+	std::vector<uint64_t> expectedScan(kCount);
+	basic::ParallelInclusiveScan(pool, input.begin(), input.end(), scanned.begin());
+	std::inclusive_scan(input.begin(), input.end(), expectedScan.begin());
+	bool const scannedOk = expectedScan == scanned;
+
+	// transform against std::transform
+	std::vector<uint64_t> transformed(kCount);
+	std::vector<uint64_t> expectedTransform(kCount);
+	auto const square = [](uint64_t value) { return value * value; };
+	basic::ParallelTransform(pool, input.begin(), input.end(), transformed.begin(), square);
+	std::transform(input.begin(), input.end(), expectedTransform.begin(), square);
+	bool const transformedOk = expectedTransform == transformed;
+
+	// sort against std::sort, with a comparator
+	std::vector<uint64_t> sorted(input);
+	std::vector<uint64_t> expectedSort(input);
+	basic::ParallelSort(pool, sorted.begin(), sorted.end(), std::greater<>());
+	std::sort(expectedSort.begin(), expectedSort.end(), std::greater<>());
+	bool const sortedOk = expectedSort == sorted;
+
+	// empty ranges
+	std::vector<uint64_t> none;
+	uint64_t const empty = basic::ParallelReduce(pool, none.begin(), none.end(), uint64_t(5));
+	basic::ParallelSort(pool, none.begin(), none.end());
+	bool const emptyOk = 5U == empty;
+
+	// a throwing body: chunks claimed afterwards are skipped and the caller gets the exception
+	std::atomic<std::size_t> visited{0U};
+	bool thrown = false;
+	try {
+		basic::ParallelFor(pool, std::size_t(0U), kCount, [&visited](std::size_t i) {
+			visited.fetch_add(1U, std::memory_order_relaxed);
+			if (kCount / 2U == i) {
+				throw std::runtime_error("chunk failed");
+			}
+		});
+	} catch (std::runtime_error const &) {
+		thrown = true;
+	}
+	std::size_t const visitedAfterThrow = visited.load();
+	bool const stopped = thrown && visitedAfterThrow < kCount;
+
+	// the pool is still usable afterwards
+	uint64_t const again = basic::ParallelReduce(pool, input.begin(), input.end(), uint64_t(0));
+	bool const usable = sum == again;
+
+	pool.Stop();
+
+	std::cout << "Parallel: reduce " << reduced << ordered << ", scan " << scannedOk << ", transform "
+	          << transformedOk << ", sort " << sortedOk << ", empty " << emptyOk << ", throw " << stopped
+	          << " after " << visitedAfterThrow << " of " << kCount << " indices, usable " << usable << std::endl;
+
+	bool const ok = reduced && ordered && scannedOk && transformedOk && sortedOk && emptyOk && stopped && usable;
+	assert(ok);
+
+	return ok ? 0 : 1;
+}
@@ -2,7 +2,12 @@
 // Created by liu on 06.01.2021.
 //
 
+#include <cassert>
+#include <chrono>
+#include <vector>
+
 #include "queue.h"
+#include "queue-set.h"
 
 auto main() -> int
 {
@@ -11,5 +16,28 @@ auto main() -> int
 	queue.Push(1);
 	queue.Push(2);
 
+	std::vector<int> const batch {3, 4};
+	queue.PushBulk(batch.begin(), batch.end());
+
+	std::vector<int> values;
+	std::size_t const popped = queue.PopBulk(std::back_inserter(values), 3);
+	assert(3 == popped);
+
+	values = queue.PopBulk(8, std::chrono::milliseconds(10));
+	assert(1 == values.size() && 4 == values.front());
+
+	basic::Queue<int> control;
+	basic::QueueSet set;
+	std::size_t const data = set.Add(queue);
+	set.Add(control);
+
+	queue.Push(5);
+	int value = 0;
+	std::size_t const ready = set.WaitAny();
+	bool const taken = queue.TryPop(value);
+	assert(data == ready && taken && 5 == value);
+	auto const timedOut = set.WaitAny(std::chrono::milliseconds(1));
+	assert(!timedOut);
+
 	return 0;
-}
\ No newline at end of file
+}
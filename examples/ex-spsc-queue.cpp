@@ -0,0 +1,62 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "queue.h"
+#include "spsc-queue.h"
+
+namespace {
+
+constexpr unsigned int kItems = 10000000;
+
+//! Hand kItems values from one producer to one consumer thread and return nanoseconds per value
+template<typename QUEUE>
+double HandOff(QUEUE &queue, unsigned int items) {
+	auto const start = std::chrono::steady_clock::now();
+
+	std::thread producer([&queue, items] {
+		for (unsigned int i = 0; i < items; ++i) {
+			queue.Push(i);
+		}
+	});
+	for (unsigned int i = 0; i < items; ++i) {
+		queue.Pop();
+	}
+	producer.join();
+
+	std::chrono::duration<double, std::nano> const elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / items;
+}
+
+} // namespace
+
+auto main() -> int
+{
+	using SpscQueue = basic::SpscQueue<unsigned int, 1024>;
+
+	// single thread push/pop pair, i.e. the bare per-element cost
+	auto spsc = std::make_unique<SpscQueue>(basic::WaitStrategy::kSpinYield);
+	unsigned int value = 0;
+	auto const start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < kItems; ++i) {
+		spsc->TryPush(i);
+		spsc->TryPop(value);
+	}
+	std::chrono::duration<double, std::nano> const elapsed = std::chrono::steady_clock::now() - start;
+	std::cout << "SpscQueue TryPush+TryPop:   " << elapsed.count() / kItems << " ns/element" << std::endl;
+
+	std::cout << "SpscQueue hand-off (spin):  " << HandOff(*spsc, kItems) << " ns/element" << std::endl;
+
+	auto parking = std::make_unique<SpscQueue>(basic::WaitStrategy::kSpinPark);
+	std::cout << "SpscQueue hand-off (park):  " << HandOff(*parking, kItems) << " ns/element" << std::endl;
+
+	basic::Queue<unsigned int> queue(1024);
+	std::cout << "Queue hand-off:             " << HandOff(queue, kItems / 10) << " ns/element" << std::endl;
+
+	return 0;
+}
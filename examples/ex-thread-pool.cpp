@@ -3,6 +3,7 @@
 //
 #include "chrono"
 #include <iostream>
+#include <string>
 
 #include "thread-pool.h"
 #include "thread.h"
@@ -26,6 +27,10 @@ int main() {
 	thread_pool.Run( [](){ std::cout << "Hello 1" << std::endl; } );
 	thread_pool.Run( [](){ std::cout << "Hello 2" << std::endl; } );
 
+	auto answer = thread_pool.Submit([](int a, int b) { return a * b; }, 6, 7)
+			.Then([](int product) { return "The answer is " + std::to_string(product); });
+	std::cout << answer.Get() << std::endl;
+
 	while(loop < 4)
 	{
 		using namespace std::chrono_literals;
@@ -6,15 +6,30 @@
 #define BASIC_SERVICES_CIRCLE_BUFFER_H
 
 #include <memory>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
 
+#include "types.h"
 #include "noncopyable.h"
 #include "basic-services_export.h"
 
 namespace basic {
 
 //! A simple template circle buffer class
-template< typename T, typename SIZE_TYPE>
+//!
+//! \brief
+//! Values are stored by value in uninitialized, suitably aligned storage, so the buffer owns
+//! them and producers do not have to keep anything alive. The capacity is rounded up to a power
+//! of two, head and tail are free running counters and slots are addressed by masking, so there
+//! is no wrap-around branch on the hot path. The class is not thread safe.
+//!
+//! \tparam T - Value type
+//! \tparam SIZE_TYPE - Unsigned type of counters and sizes
+template< typename T, typename SIZE_TYPE = std::size_t>
 class BASIC_SERVICES_EXPORT CircleBuffer : public noncopyable {
+	static_assert(std::is_unsigned<SIZE_TYPE>::value, "SIZE_TYPE must be an unsigned type");
+
 public:
 	using value_type        = T;
 	using size_type         = SIZE_TYPE;
@@ -22,79 +37,207 @@ public:
 	using const_pointer     = const T *;
 	using reference         = T&;
 	using const_reference   = const T&;
+	using span_type         = Span<T>;
 public:
 	//! Default constructor
+	//!
+	//! \param size - Capacity, rounded up to the next power of two (at most half the range of SIZE_TYPE)
 	explicit CircleBuffer(size_type size)
-		: m_front(), m_end(size), m_head(0U), m_tail(0U), m_free(size + 1U)
-		, m_ring(std::make_unique<const_pointer[]>(size))
+		: m_mask(size_type(roundUpPowerOfTwo(size ? size : 1U) - 1U))
+		, m_ring(std::make_unique<Storage[]>(std::size_t(m_mask) + 1U))
 	{}
 
-	//! Get one value from the circle buffer
-	const_pointer get() noexcept {
-		// always remove the value from the front location
-		const_pointer value = m_front;
-
-		// when the queue is not empty
-		if (nullptr != value) {
-			// update the number of fee value
-			++m_free;
-			// value in the array ?
-			if (m_free <= m_end) {
-				// remove from the tail
-				m_front = m_ring[m_tail];
-				if (0U == m_tail) {
-					// wrap around
-					m_tail = m_end;
-				}
-				--m_tail;
-			} else {
-				// queue becomes empty
-				m_front = nullptr;
-			}
+	//! Destructor
+	~CircleBuffer() {
+		clear();
+	}
+
+	//! Number of values in the buffer
+	size_type size() const noexcept {
+		return size_type(m_head - m_tail);
+	}
+
+	//! Maximum number of values in the buffer
+	size_type capacity() const noexcept {
+		return m_mask + 1U;
+	}
+
+	//! Query whether the buffer is empty
+	bool empty() const noexcept {
+		return m_head == m_tail;
+	}
+
+	//! Query whether the buffer is full
+	bool full() const noexcept {
+		return size() > m_mask;
+	}
+
+	//! Construct one value in place at the end of the buffer
+	//!
+	//! \retval true - Value posted
+	//! \retval false - Buffer is full
+	template<typename... Args>
+	bool emplace(Args &&... args) {
+		if (full()) {
+			return false;
 		}
 
-		return value;
+		::new(static_cast<void *>(slot(m_head))) value_type(std::forward<Args>(args)...);
+		++m_head;
+		return true;
 	}
 
 	//! Post one value into the circle buffer
-	bool post(const_pointer const value) noexcept {
-		bool status;
-		if (m_free) {
-			--m_free;
-			// if queue is empty
-			if (nullptr == m_front) {
-				m_front = value;
-			} else {
-				m_ring[m_head] = value;
-
-				if(m_head == 0U) {
-					// wrap around
-					m_head = m_end;
-				}
-
-				--m_head;
+	//!
+	//! \retval true - Value posted
+	//! \retval false - Buffer is full
+	bool post(const_reference value) {
+		return emplace(value);
+	}
+
+	//! Move one value into the circle buffer
+	//!
+	//! \retval true - Value posted
+	//! \retval false - Buffer is full
+	bool post(value_type &&value) {
+		return emplace(std::move(value));
+	}
+
+	//! Post one value into the circle buffer, overwriting the oldest value if it is full
+	//!
+	//! \note For a buffer shared between threads see FlightRecorder.
+	//! \retval true - The oldest value was overwritten
+	//! \retval false - The value fitted
+	template<typename U>
+	bool postOverwrite(U &&value) {
+		bool const overwrite = full();
+		if (overwrite) {
+			pop();
+		}
+
+		emplace(std::forward<U>(value));
+		return overwrite;
+	}
+
+	//! Post a range of values into the circle buffer
+	//!
+	//! \param first - Begin of the range
+	//! \param last - End of the range
+	//! \return Number of values posted, stops at the first value which does not fit
+	template<typename InputIt>
+	size_type post(InputIt first, InputIt last) {
+		size_type posted = 0U;
+		for (; first != last && !full(); ++first, ++posted) {
+			::new(static_cast<void *>(slot(m_head))) value_type(*first);
+			++m_head;
+		}
+		return posted;
+	}
+
+	//! Access the oldest value in place
+	//!
+	//! \return Pointer to the oldest value, nullptr if the buffer is empty
+	pointer front() noexcept {
+		return empty() ? nullptr : slot(m_tail);
+	}
+
+	//! Remove the oldest value, the buffer must not be empty
+	void pop() noexcept {
+		slot(m_tail)->~value_type();
+		++m_tail;
+	}
+
+	//! Get one value from the circle buffer
+	//!
+	//! \param value - Receives the oldest value
+	//! \retval true - Value returned
+	//! \retval false - Buffer is empty
+	bool get(reference value) {
+		if (empty()) {
+			return false;
+		}
+
+		value = std::move(*slot(m_tail));
+		pop();
+		return true;
+	}
+
+	//! Get several values from the circle buffer
+	//!
+	//! \param out - Output iterator receiving the values
+	//! \param max_n - Maximum number of values
+	//! \return Number of values returned
+	template<typename OutputIt>
+	size_type get(OutputIt out, size_type max_n) {
+		size_type const count = std::min(max_n, size());
+		for (size_type i = 0U; i < count; ++i) {
+			*out++ = std::move(*slot(m_tail));
+			pop();
+		}
+		return count;
+	}
+
+	//! Remove all values
+	void clear() noexcept {
+		if (!std::is_trivially_destructible<value_type>::value) {
+			while (!empty()) {
+				pop();
 			}
-			status = true; // value posted sucessfully
-		} else {
-			status = false;
 		}
+		m_tail = m_head;
+	}
 
-		return status;
+	//! Contiguous region of values, starting with the oldest one
+	//!
+	//! \note
+	//! The region ends at the end of the storage, so it may hold fewer than size() values;
+	//! after consume() the next call returns the remaining values.
+	span_type readable() noexcept {
+		size_type const offset = m_tail & m_mask;
+		return span_type(slot(m_tail), std::min<size_type>(size(), capacity() - offset));
+	}
+
+	//! Remove the first count values of the readable region
+	void consume(size_type count) noexcept {
+		if (std::is_trivially_destructible<value_type>::value) {
+			m_tail += count;
+			return;
+		}
+		for (size_type i = 0U; i < count; ++i) {
+			pop();
+		}
 	}
 
+	//! Contiguous region of free slots, following the newest value
 	//!
-	bool empty() const noexcept
-	{
-		return nullptr == pointer(0);
+	//! \note
+	//! The slots are not initialized, so the region is only offered for trivially copyable types.
+	//! Write the values, then publish them with commit().
+	span_type writable() noexcept {
+		static_assert(std::is_trivially_copyable<value_type>::value,
+		              "writable regions are only available for trivially copyable types");
+		size_type const offset = m_head & m_mask;
+		return span_type(slot(m_head), std::min<size_type>(capacity() - size(), capacity() - offset));
 	}
+
+	//! Publish the first count values written to the writable region
+	void commit(size_type count) noexcept {
+		m_head += count;
+	}
+
+private:
+	using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	pointer slot(size_type index) const noexcept {
+		return reinterpret_cast<pointer>(&m_ring[index & m_mask]);
+	}
+
 private:
-	const_pointer m_front;	//!< Value at the front of the queue
-	size_type m_end;		//!< Value at the end of the queue
-	size_type m_head;       //!< Head index where value will be inserted
-	size_type m_tail;       //!< End index where value will be extracted
-	size_type m_free;       //!< Number of free places
+	size_type const m_mask;         //!< Capacity - 1
+	size_type m_head = 0U;          //!< Counter of posted values, masked it is the next slot to fill
+	size_type m_tail = 0U;          //!< Counter of removed values, masked it is the oldest slot
 
-	std::unique_ptr<const_pointer[]> m_ring;    //!< Instance of ring buffer
+	std::unique_ptr<Storage[]> m_ring;    //!< Value storage
 
 };
 
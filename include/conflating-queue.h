@@ -0,0 +1,226 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_CONFLATING_QUEUE_H
+#define BASIC_SERVICES_CONFLATING_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "noncopyable.h"
+#include "queue-storage.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class ConflatingQueue
+//!
+//! \brief
+//! A thread safe queue which only keeps the newest value per key
+//!
+//! \note
+//! Pushing a value for a key which is still pending overwrites the pending value in place and
+//! keeps the key at its position, so consumers see every key at most once, in the order the keys
+//! became pending, always with their latest value. The depth of the queue is bounded by the
+//! number of distinct keys. Map nodes of popped keys are kept for reuse, so a queue does not
+//! allocate once it has seen its peak number of pending keys.
+//!
+//! \tparam Key - Key type
+//! \tparam T - Value type
+//! \tparam Hash - Hash function of the key
+template<typename Key, typename T, typename Hash = std::hash<Key>>
+class BASIC_SERVICES_EXPORT ConflatingQueue : public noncopyable {
+public:
+	using key_type = Key;
+	using value_type = T;
+	using reference = T &;
+	using const_reference = const T &;
+
+public:
+	//! Constructor
+	//!
+	//! \param cap - Maximum number of pending keys (0 means unlimited)
+	explicit ConflatingQueue(std::size_t cap = 0)
+			: m_capacity(cap), m_order(cap) {
+		m_pending.reserve(cap);
+	}
+
+	//! Destructor
+	~ConflatingQueue() = default;
+
+	//! Query whether queue is empty
+	bool isEmpty() const {
+		return 0 == Size();
+	}
+
+	//! Query the number of pending keys
+	std::size_t Size() const {
+		return m_size.load(std::memory_order_relaxed);
+	}
+
+	//! Query the capacity of the queue
+	std::size_t getCapacity() const {
+		return m_capacity;
+	}
+
+	//! Query the number of values which were overwritten before being popped
+	std::size_t getConflated() const {
+		return m_conflated.load(std::memory_order_relaxed);
+	}
+
+	//! Clear the queue
+	void Clear() {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		while (!m_order.empty()) {
+			m_spare.push_back(m_pending.extract(m_order.front()));
+			m_order.pop();
+		}
+		m_size.store(0, std::memory_order_relaxed);
+		m_condPop.notify_all();
+	}
+
+	//! Push the newest value of a key
+	//!
+	//! \note
+	//! If the key is not pending and the capacity is reached the caller blocks until a key is popped.
+	//! \param key - Key
+	//! \param value - Value of the key
+	//! \retval true - The key became pending
+	//! \retval false - The key was pending, its value was overwritten
+	bool Push(key_type const &key, const_reference value) {
+		return push(key, value);
+	}
+
+	//! Move the newest value of a key into the queue
+	//!
+	//! \note
+	//! If the key is not pending and the capacity is reached the caller blocks until a key is popped.
+	//! \param key - Key
+	//! \param value - Value of the key
+	//! \retval true - The key became pending
+	//! \retval false - The key was pending, its value was overwritten
+	bool Push(key_type const &key, value_type &&value) {
+		return push(key, std::move(value));
+	}
+
+	//! Pop the oldest pending key with its newest value
+	//!
+	//! \note
+	//! If the queue is empty the caller blocks until a value is pushed into the queue.
+	//! \return Key and value
+	std::pair<key_type, value_type> Pop() {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		m_condPush.wait(lk, [this] { return !m_order.empty(); });
+
+		return pop();
+	}
+
+	//! Pop the oldest pending key with its newest value, with timeout
+	//!
+	//! \param key - Receives the key
+	//! \param value - Receives the value
+	//! \param timeout - Maximum time to wait for a key
+	//! \retval true - Key popped
+	//! \retval false - Timeout
+	template<typename Rep, typename Period>
+	bool Pop(key_type &key, reference value, std::chrono::duration<Rep, Period> const &timeout) {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		if (!m_condPush.wait_for(lk, timeout, [this] { return !m_order.empty(); })) {
+			return false;
+		}
+
+		std::tie(key, value) = pop();
+		return true;
+	}
+
+	//! Try to pop the oldest pending key with its newest value
+	//!
+	//! \param key - Receives the key
+	//! \param value - Receives the value
+	//! \retval true - Key popped
+	//! \retval false - Queue is empty
+	bool TryPop(key_type &key, reference value) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		if (m_order.empty()) {
+			return false;
+		}
+
+		std::tie(key, value) = pop();
+		return true;
+	}
+
+private:
+	using Map = std::unordered_map<key_type, value_type, Hash>;
+
+	template<typename U>
+	bool push(key_type const &key, U &&value) {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		auto it = m_pending.find(key);
+		if (it != m_pending.end()) {
+			it->second = std::forward<U>(value);
+			m_conflated.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		if (m_capacity > 0 && m_order.size() >= m_capacity) {
+			m_condPop.wait(lk, [this] { return 0 == m_capacity || m_order.size() < m_capacity; });
+			// the key may have become pending while waiting
+			it = m_pending.find(key);
+			if (it != m_pending.end()) {
+				it->second = std::forward<U>(value);
+				m_conflated.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+		}
+
+		if (m_spare.empty()) {
+			m_pending.emplace(key, std::forward<U>(value));
+		} else {
+			typename Map::node_type node = std::move(m_spare.back());
+			m_spare.pop_back();
+			node.key() = key;
+			node.mapped() = std::forward<U>(value);
+			m_pending.insert(std::move(node));
+		}
+		m_order.push(key);
+		m_size.store(m_order.size(), std::memory_order_relaxed);
+		m_condPush.notify_one();
+
+		return true;
+	}
+
+	//! Remove the oldest pending key (lock must be held)
+	std::pair<key_type, value_type> pop() {
+		typename Map::node_type node = m_pending.extract(m_order.front());
+		m_order.pop();
+		m_size.store(m_order.size(), std::memory_order_relaxed);
+
+		std::pair<key_type, value_type> entry(std::move(node.key()), std::move(node.mapped()));
+		m_spare.push_back(std::move(node));
+		m_condPop.notify_one();
+
+		return entry;
+	}
+
+private:
+	std::size_t const m_capacity;                   //!< Maximum number of pending keys (0 means unlimited)
+	Map m_pending;                                  //!< Newest value of every pending key
+	detail::QueueStorage<key_type> m_order;         //!< Pending keys in the order they became pending
+	std::vector<typename Map::node_type> m_spare;   //!< Map nodes kept for reuse
+	std::atomic<std::size_t> m_size{0};             //!< Number of pending keys, readable without the lock
+	std::atomic<std::size_t> m_conflated{0};        //!< Number of overwritten values
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condPop;
+	std::condition_variable m_condPush;
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_CONFLATING_QUEUE_H
@@ -0,0 +1,86 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_CPU_SET_H
+#define BASIC_SERVICES_CPU_SET_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class CpuSet
+//!
+//! \brief
+//! A set of logical CPU numbers a thread may run on
+//!
+//! \note
+//! An empty set means no restriction. Pinning is supported on Linux and Windows (first 64 CPUs
+//! of the processor group), elsewhere Apply() fails and threads stay where the OS puts them.
+class BASIC_SERVICES_EXPORT CpuSet {
+public:
+	//! Constructor of an empty set
+	CpuSet() = default;
+
+	//! Parse a CPU list such as "0-3,8,10-11" (format of Linux sysfs and taskset)
+	//!
+	//! \param list - CPU list
+	//! \return Set of the listed CPUs, empty if the list is malformed
+	static CpuSet Parse(std::string const &list);
+
+	//! Query the CPUs the calling process may run on
+	static CpuSet getAvailable();
+
+	//! Query the CPU the calling thread runs on
+	//!
+	//! \return CPU number, or -1 if unknown
+	static int getCurrentCpu();
+
+	//! Add a CPU
+	void Add(unsigned int cpu);
+
+	//! Add all CPUs of another set
+	void Add(CpuSet const &rhs);
+
+	//! Remove a CPU
+	void Remove(unsigned int cpu);
+
+	//! Check whether a CPU is in the set
+	bool has(unsigned int cpu) const;
+
+	//! Query the number of CPUs in the set
+	std::size_t getCount() const;
+
+	//! Query whether the set is empty
+	bool isEmpty() const;
+
+	//! Retrieve the CPU numbers in ascending order
+	std::vector<unsigned int> getCpus() const;
+
+	//! Format the set as CPU list, see Parse()
+	std::string toString() const;
+
+	//! Pin the calling thread to the CPUs of the set
+	//!
+	//! \retval true - Thread pinned
+	//! \retval false - Set is empty or pinning failed or is not supported
+	bool Apply() const;
+
+	bool operator==(CpuSet const &rhs) const;
+
+	bool operator!=(CpuSet const &rhs) const {
+		return !(*this == rhs);
+	}
+
+private:
+	std::vector<uint64_t> m_words;  //!< Bit n of word n / 64 is set for CPU n
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_CPU_SET_H
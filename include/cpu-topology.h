@@ -0,0 +1,84 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_CPU_TOPOLOGY_H
+#define BASIC_SERVICES_CPU_TOPOLOGY_H
+
+#include <vector>
+#include <cstddef>
+
+#include "cpu-set.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! How workers are spread over the cores
+enum class Placement : uint8_t {
+	kCompact,   //!< fill the cores of one node after the other
+	kScatter,   //!< take the cores of all nodes in turn
+	kNode       //!< only the cores of one node
+};
+
+//! Class CpuTopology
+//!
+//! \brief
+//! The CPUs available to the process, grouped into cores, packages and NUMA nodes
+//!
+//! \note
+//! On Linux the topology is read from sysfs; elsewhere every available CPU is its own core on
+//! one node. Nodes are numbered densely from 0 on, skipping nodes without available CPUs.
+class BASIC_SERVICES_EXPORT CpuTopology {
+public:
+	//! Logical CPU
+	struct Cpu {
+		unsigned int id;        //!< CPU number
+		unsigned int core;      //!< Core number, unique over all packages
+		unsigned int package;   //!< Physical package (socket)
+		unsigned int node;      //!< NUMA node
+	};
+
+public:
+	//! Detect the topology of the machine
+	static CpuTopology Detect();
+
+	//! Query the number of NUMA nodes with available CPUs
+	std::size_t getNodeCount() const;
+
+	//! Retrieve the available CPUs, ordered by node, package, core and CPU number
+	std::vector<Cpu> const &getCpus() const;
+
+	//! Retrieve the available CPUs of a node
+	CpuSet getNodeCpus(std::size_t node) const;
+
+	//! Query the NUMA node of a CPU
+	//!
+	//! \return Node, or 0 if the CPU is unknown
+	std::size_t getNode(int cpu) const;
+
+	//! Query the NUMA node the calling thread runs on
+	std::size_t getCurrentNode() const;
+
+	//! Compute the CPUs of workers
+	//!
+	//! \param placement - How workers are spread over the cores
+	//! \param count - Number of workers, 0 for one worker per core
+	//! \param node - Node of Placement::kNode
+	//! \return One set per worker, each holding the CPUs of one core; with more workers than
+	//!         cores the cores are used again
+	std::vector<CpuSet> Place(Placement placement, std::size_t count = 0, std::size_t node = 0) const;
+
+private:
+	//! Constructor, see Detect()
+	explicit CpuTopology(std::vector<Cpu> cpus);
+
+	//! Cores in placement order, each as the set of its CPUs
+	std::vector<CpuSet> getCores(Placement placement, std::size_t node) const;
+
+	std::vector<Cpu> m_cpus;                //!< Available CPUs
+	std::vector<std::size_t> m_nodes;       //!< Node numbers with available CPUs, ascending
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_CPU_TOPOLOGY_H
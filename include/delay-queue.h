@@ -0,0 +1,219 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_DELAY_QUEUE_H
+#define BASIC_SERVICES_DELAY_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <condition_variable>
+
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class DelayQueue
+//!
+//! \brief
+//! A thread safe queue whose values become visible to consumers at a deadline
+//!
+//! \note
+//! Pending values are kept in a binary min-heap ordered by deadline (values with equal deadlines
+//! stay in push order), so Push and Pop cost O(log n) without any timer object per value.
+//! Consumers sleep until the earliest deadline and are only woken up early when a push brings
+//! the deadline forward.
+//!
+//! \tparam T - Value type
+template<typename T>
+class BASIC_SERVICES_EXPORT DelayQueue : public noncopyable {
+public:
+	using value_type = T;
+	using reference = T &;
+	using const_reference = const T &;
+	using clock = std::chrono::steady_clock;
+	using time_point = clock::time_point;
+
+public:
+	//! Constructor
+	DelayQueue() = default;
+
+	//! Destructor
+	~DelayQueue() = default;
+
+	//! Query whether queue is empty
+	bool isEmpty() const {
+		return 0 == Size();
+	}
+
+	//! Query the number of pending values, including the ones not yet ready
+	std::size_t Size() const {
+		return m_size.load(std::memory_order_relaxed);
+	}
+
+	//! Reserve storage for a number of pending values
+	void Reserve(std::size_t count) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_heap.reserve(count);
+	}
+
+	//! Clear the queue
+	void Clear() {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_heap.clear();
+		m_size.store(0, std::memory_order_relaxed);
+	}
+
+	//! Push value into the queue
+	//!
+	//! \param value - Value to be pushed
+	//! \param readyAt - Point in time from which on the value may be popped
+	void Push(const_reference value, time_point readyAt) {
+		push(value, readyAt);
+	}
+
+	//! Move value into the queue
+	//!
+	//! \param value - Value to be pushed
+	//! \param readyAt - Point in time from which on the value may be popped
+	void Push(value_type &&value, time_point readyAt) {
+		push(std::move(value), readyAt);
+	}
+
+	//! Push value into the queue, ready after a delay
+	//!
+	//! \param value - Value to be pushed
+	//! \param delay - Time from now on after which the value may be popped
+	template<typename U, typename Rep, typename Period>
+	void Push(U &&value, std::chrono::duration<Rep, Period> const &delay) {
+		push(std::forward<U>(value), clock::now() + std::chrono::duration_cast<clock::duration>(delay));
+	}
+
+	//! Pop value out of the queue
+	//!
+	//! \note
+	//! The caller blocks until the value with the earliest deadline is ready.
+	//! \return Value be popped
+	value_type Pop() {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		for (;;) {
+			if (m_heap.empty()) {
+				m_cond.wait(lk);
+			} else if (clock::now() < m_heap.front().readyAt) {
+				m_cond.wait_until(lk, m_heap.front().readyAt);
+			} else {
+				return pop();
+			}
+		}
+	}
+
+	//! Pop value out of the queue with timeout
+	//!
+	//! \param value - Receives the popped value
+	//! \param timeout - Maximum time to wait for a value to become ready
+	//! \retval true - Value popped
+	//! \retval false - Timeout
+	template<typename Rep, typename Period>
+	bool Pop(reference value, std::chrono::duration<Rep, Period> const &timeout) {
+		time_point const deadline = clock::now() + std::chrono::duration_cast<clock::duration>(timeout);
+		std::unique_lock<std::mutex> lk(m_mutex);
+		for (;;) {
+			time_point const now = clock::now();
+			if (!m_heap.empty() && now >= m_heap.front().readyAt) {
+				value = pop();
+				return true;
+			}
+			if (now >= deadline) {
+				return false;
+			}
+			m_cond.wait_until(lk, m_heap.empty() ? deadline : std::min(deadline, m_heap.front().readyAt));
+		}
+	}
+
+	//! Try to pop a ready value out of the queue
+	//!
+	//! \param value - Receives the popped value
+	//! \retval true - Value popped
+	//! \retval false - No value is ready
+	bool TryPop(reference value) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		if (m_heap.empty() || clock::now() < m_heap.front().readyAt) {
+			return false;
+		}
+
+		value = pop();
+		return true;
+	}
+
+	//! Query the earliest deadline
+	//!
+	//! \param readyAt - Receives the earliest deadline
+	//! \retval true - Deadline returned
+	//! \retval false - Queue is empty
+	bool getNextReadyTime(time_point &readyAt) const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		if (m_heap.empty()) {
+			return false;
+		}
+
+		readyAt = m_heap.front().readyAt;
+		return true;
+	}
+
+private:
+	//! Pending value
+	struct Entry {
+		time_point readyAt;     //!< Deadline
+		uint64_t sequence;      //!< Push order, breaks ties between equal deadlines
+		value_type value;
+	};
+
+	//! Heap order, the earliest deadline on top
+	static bool later(Entry const &lhs, Entry const &rhs) {
+		return lhs.readyAt > rhs.readyAt || (lhs.readyAt == rhs.readyAt && lhs.sequence > rhs.sequence);
+	}
+
+	template<typename U>
+	void push(U &&value, time_point readyAt) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_heap.push_back(Entry{readyAt, m_sequence++, std::forward<U>(value)});
+		std::push_heap(m_heap.begin(), m_heap.end(), later);
+		m_size.store(m_heap.size(), std::memory_order_relaxed);
+
+		// consumers only need to recompute their sleep if the earliest deadline changed
+		if (m_heap.front().sequence + 1U == m_sequence) {
+			m_cond.notify_one();
+		}
+	}
+
+	//! Remove the value with the earliest deadline (lock must be held)
+	value_type pop() {
+		std::pop_heap(m_heap.begin(), m_heap.end(), later);
+		value_type value(std::move(m_heap.back().value));
+		m_heap.pop_back();
+		m_size.store(m_heap.size(), std::memory_order_relaxed);
+
+		// the next value may already be due for another consumer
+		if (!m_heap.empty()) {
+			m_cond.notify_one();
+		}
+		return value;
+	}
+
+private:
+	std::vector<Entry> m_heap;              //!< Pending values, min-heap by deadline
+	uint64_t m_sequence = 0U;               //!< Sequence of the next push
+	std::atomic<std::size_t> m_size{0};     //!< Size of m_heap, readable without the lock
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cond;
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_DELAY_QUEUE_H
@@ -0,0 +1,99 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_EVENT_FD_H
+#define BASIC_SERVICES_EVENT_FD_H
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/eventfd.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class EventFd
+//!
+//! \brief
+//! A file descriptor which is readable while the event is signalled, for use in poll/epoll loops
+//!
+//! \note
+//! Uses an eventfd on Linux and a non-blocking pipe on other unix systems. Not available on
+//! Windows, where the instance is always invalid. Signal() and Drain() are not synchronized with
+//! each other, the owner serializes them.
+class BASIC_SERVICES_EXPORT EventFd : public noncopyable {
+public:
+	//! Constructor
+	EventFd() {
+#if defined(__linux__)
+		m_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		m_writeFd = m_fd;
+#elif defined(__unix__) || defined(__APPLE__)
+		int fds[2];
+		if (0 == ::pipe(fds)) {
+			for (int fd : fds) {
+				::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+				::fcntl(fd, F_SETFD, FD_CLOEXEC);
+			}
+			m_fd = fds[0];
+			m_writeFd = fds[1];
+		}
+#endif
+	}
+
+	//! Destructor
+	~EventFd() {
+#if defined(__unix__) || defined(__APPLE__)
+		if (m_writeFd >= 0 && m_writeFd != m_fd) {
+			::close(m_writeFd);
+		}
+		if (m_fd >= 0) {
+			::close(m_fd);
+		}
+#endif
+	}
+
+	//! Check validity of the instance
+	explicit operator bool() const noexcept { return m_fd >= 0; }
+
+	//! Query the file descriptor to wait on for readability
+	int getFd() const noexcept { return m_fd; }
+
+	//! Signal the event, making the descriptor readable
+	void Signal() {
+#if defined(__linux__)
+		uint64_t const one = 1U;
+		(void) !::write(m_writeFd, &one, sizeof(one));
+#elif defined(__unix__) || defined(__APPLE__)
+		uint8_t const one = 1U;
+		(void) !::write(m_writeFd, &one, sizeof(one));
+#endif
+	}
+
+	//! Reset the event, making the descriptor unreadable
+	void Drain() {
+#if defined(__linux__)
+		uint64_t count;
+		(void) !::read(m_fd, &count, sizeof(count));
+#elif defined(__unix__) || defined(__APPLE__)
+		uint8_t buffer[64];
+		while (::read(m_fd, buffer, sizeof(buffer)) > 0) {}
+#endif
+	}
+
+private:
+	int m_fd = -1;          //!< Descriptor to wait on
+	int m_writeFd = -1;     //!< Descriptor to signal (same as m_fd for an eventfd)
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_EVENT_FD_H
@@ -5,6 +5,8 @@
 #ifndef BASIC_SERVICES_EVENT_H
 #define BASIC_SERVICES_EVENT_H
 
+#include <cstdint>
+
 #include "basic-services_export.h"
 
 namespace basic {
@@ -0,0 +1,143 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_FLIGHT_RECORDER_H
+#define BASIC_SERVICES_FLIGHT_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class FlightRecorder
+//!
+//! \brief
+//! A ring which always keeps the last N records of a single writer, overwriting the oldest ones,
+//! and lets other threads take consistent snapshots at any time
+//!
+//! \note
+//! Record() is wait-free: it bumps the sequence of the slot to an odd value, writes the record
+//! and bumps the sequence to an even value (a per-slot seqlock), without ever waiting for readers.
+//! Snapshot() copies every slot and keeps it only if its sequence was even and unchanged during
+//! the copy, so a record the writer overwrote meanwhile is skipped instead of being torn.
+//! Records are numbered from 0 on; gaps in the numbers of a snapshot show overwritten records.
+//!
+//! \tparam T - Record type, must be trivially copyable
+//! \tparam N - Number of kept records, must be a power of two
+template<typename T, std::size_t N>
+class BASIC_SERVICES_EXPORT FlightRecorder : public noncopyable {
+	static_assert(std::is_trivially_copyable<T>::value, "records of a FlightRecorder must be trivially copyable");
+	static_assert(N >= 1U && 0U == (N & (N - 1U)), "capacity must be a power of two");
+
+public:
+	using value_type = T;
+	using const_reference = const T &;
+
+	//! Record with its number
+	struct Entry {
+		uint64_t sequence;  //!< Number of the record
+		value_type value;   //!< Record
+	};
+
+public:
+	//! Constructor
+	FlightRecorder() {
+		for (auto &slot : m_slots) {
+			slot.m_sequence.store(0U, std::memory_order_relaxed);
+		}
+	}
+
+	//! Destructor
+	~FlightRecorder() = default;
+
+	//! Query the capacity
+	static constexpr std::size_t getCapacity() {
+		return N;
+	}
+
+	//! Query the number of records written so far
+	uint64_t getCount() const {
+		return m_next.load(std::memory_order_acquire);
+	}
+
+	//! Add a record, overwriting the oldest one (single writer only)
+	//!
+	//! \param value - Record
+	//! \return Number of the record
+	uint64_t Record(const_reference value) {
+		uint64_t const sequence = m_next.load(std::memory_order_relaxed);
+		Slot &slot = m_slots[sequence & (N - 1U)];
+
+		uint64_t words[kWords] = {};
+		std::memcpy(words, &value, sizeof(T));
+
+		slot.m_sequence.store(2U * sequence + 1U, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		for (std::size_t i = 0; i < kWords; ++i) {
+			slot.m_words[i].store(words[i], std::memory_order_relaxed);
+		}
+		slot.m_sequence.store(2U * sequence + 2U, std::memory_order_release);
+
+		m_next.store(sequence + 1U, std::memory_order_release);
+		return sequence;
+	}
+
+	//! Take a snapshot of the last records (any thread)
+	//!
+	//! \param entries - Receives the records, oldest first
+	//! \return Number of records in the snapshot
+	std::size_t Snapshot(std::vector<Entry> &entries) const {
+		entries.clear();
+		uint64_t const next = m_next.load(std::memory_order_acquire);
+		uint64_t const first = (next > N) ? next - N : 0U;
+		entries.reserve(std::size_t(next - first));
+
+		for (uint64_t sequence = first; sequence < next; ++sequence) {
+			Slot const &slot = m_slots[sequence & (N - 1U)];
+			uint64_t const expected = 2U * sequence + 2U;
+			if (slot.m_sequence.load(std::memory_order_acquire) != expected) {
+				// overwritten since next was read
+				continue;
+			}
+
+			uint64_t words[kWords];
+			for (std::size_t i = 0; i < kWords; ++i) {
+				words[i] = slot.m_words[i].load(std::memory_order_relaxed);
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.m_sequence.load(std::memory_order_relaxed) != expected) {
+				continue;
+			}
+
+			Entry entry{sequence, value_type()};
+			std::memcpy(&entry.value, words, sizeof(T));
+			entries.push_back(entry);
+		}
+
+		return entries.size();
+	}
+
+private:
+	static constexpr std::size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1U) / sizeof(uint64_t);
+
+	//! Record slot, the record is kept in atomic words so that readers may copy it concurrently
+	struct Slot {
+		std::atomic<uint64_t> m_sequence;           //!< 2 * number + 1 while written, 2 * number + 2 once written
+		std::atomic<uint64_t> m_words[kWords];      //!< Record
+	};
+
+	alignas(kCacheLineSize) std::atomic<uint64_t> m_next{0U};  //!< Number of the next record
+	alignas(kCacheLineSize) Slot m_slots[N];                   //!< Ring of records
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_FLIGHT_RECORDER_H
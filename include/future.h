@@ -0,0 +1,334 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_FUTURE_H
+#define BASIC_SERVICES_FUTURE_H
+
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <type_traits>
+#include <condition_variable>
+
+#include "task.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+template<typename R>
+class Future;
+
+namespace detail {
+
+//! Stand-in value of Future<void>
+struct Unit {};
+
+template<typename R>
+using StoredType = std::conditional_t<std::is_void<R>::value, Unit, R>;
+
+//! Invoke func and return its result as stored by a future
+template<typename R, typename F>
+StoredType<R> invokeStored(F &&func) {
+	if constexpr (std::is_void<R>::value) {
+		std::forward<F>(func)();
+		return Unit{};
+	} else {
+		return std::forward<F>(func)();
+	}
+}
+
+//! Shared state of a Promise and its Future
+template<typename R>
+class BASIC_SERVICES_NO_EXPORT FutureState : public noncopyable {
+public:
+	using Stored = StoredType<R>;
+
+	explicit FutureState(Executor *executor)
+			: m_executor(executor) {}
+
+	Executor *getExecutor() const noexcept {
+		return m_executor;
+	}
+
+	bool isReady() const noexcept {
+		return m_ready.load(std::memory_order_acquire);
+	}
+
+	void setValue(Stored &&value) {
+		complete([this, &value] { m_value.emplace(std::move(value)); });
+	}
+
+	//! Complete with an error instead of a value
+	void setError(std::exception_ptr error) {
+		complete([this, &error] { m_error = std::move(error); });
+	}
+
+	void setContinuation(Task &&continuation) {
+		{
+			std::lock_guard<std::mutex> lk(m_mutex);
+			if (!isReady()) {
+				m_continuation = std::move(continuation);
+				return;
+			}
+		}
+		schedule(std::move(continuation));
+	}
+
+	void wait() {
+		if (!isReady()) {
+			std::unique_lock<std::mutex> lk(m_mutex);
+			m_cond.wait(lk, [this] { return isReady(); });
+		}
+	}
+
+	template<typename Clock, typename Duration>
+	bool waitUntil(std::chrono::time_point<Clock, Duration> const &deadline) {
+		if (isReady()) {
+			return true;
+		}
+		std::unique_lock<std::mutex> lk(m_mutex);
+		return m_cond.wait_until(lk, deadline, [this] { return isReady(); });
+	}
+
+	Stored &value() noexcept {
+		return *m_value;
+	}
+
+	//! Error of a ready state, nullptr if it holds a value
+	std::exception_ptr const &getError() const noexcept {
+		return m_error;
+	}
+
+private:
+	//! Store the result and hand on the continuation, which may own this state
+	template<typename Store>
+	void complete(Store &&store) {
+		Task continuation;
+		{
+			std::lock_guard<std::mutex> lk(m_mutex);
+			store();
+			m_ready.store(true, std::memory_order_release);
+			continuation = std::move(m_continuation);
+		}
+		m_cond.notify_all();
+
+		if (continuation) {
+			schedule(std::move(continuation));
+		}
+	}
+
+	void schedule(Task &&task) {
+		if (nullptr != m_executor) {
+			m_executor->Execute(std::move(task));
+		} else {
+			task();
+		}
+	}
+
+	Executor *const m_executor;             //!< Runs continuations, inline if nullptr
+	std::atomic<bool> m_ready{false};       //!< Value is set
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::optional<Stored> m_value;          //!< Result
+	std::exception_ptr m_error;             //!< Error instead of a result
+	Task m_continuation;                    //!< Runs once the value or error is set
+};
+
+template<typename R, typename F>
+using ContinuationResult = std::conditional_t<std::is_void<R>::value,
+		std::invoke_result<F &>, std::invoke_result<F &, StoredType<R> &&> >;
+
+} // namespace detail
+
+//! Template Class Promise
+//!
+//! \brief
+//! Producing side of a Future, move-only
+//!
+//! \note
+//! A Promise destroyed without a value completes its Future with std::future_error
+//! (std::future_errc::broken_promise), e.g. when a stopped ThreadPool drops the task holding it.
+template<typename R>
+class BASIC_SERVICES_EXPORT Promise {
+public:
+	//! Constructor
+	//!
+	//! \param executor - Runs the continuations of the future, nullptr runs them inline
+	explicit Promise(Executor *executor = nullptr)
+			: m_state(std::make_shared<detail::FutureState<R> >(executor)) {}
+
+	//! Move constructor
+	Promise(Promise &&) noexcept = default;
+
+	//! Move assignment
+	Promise &operator=(Promise &&rhs) noexcept {
+		release();
+		m_state = std::move(rhs.m_state);
+		return *this;
+	}
+
+	//! Destructor
+	~Promise() {
+		release();
+	}
+
+	//! Retrieve the future, once
+	Future<R> getFuture() {
+		return Future<R>(m_state);
+	}
+
+	//! Fulfil the future
+	template<typename... V>
+	void setValue(V &&... value) {
+		if constexpr (std::is_void<R>::value) {
+			static_assert(0U == sizeof...(V), "Promise<void>::setValue takes no value");
+			m_state->setValue(detail::Unit{});
+		} else {
+			m_state->setValue(R(std::forward<V>(value)...));
+		}
+	}
+
+	//! Fulfil the future with the result of a callable, or with the exception it throws
+	template<typename F>
+	void setValueWith(F &&func) {
+		try {
+			m_state->setValue(detail::invokeStored<R>(std::forward<F>(func)));
+		} catch (...) {
+			m_state->setError(std::current_exception());
+		}
+	}
+
+	//! Complete the future with an error, Future::Get() rethrows it
+	void setException(std::exception_ptr error) {
+		m_state->setError(std::move(error));
+	}
+
+private:
+	void release() {
+		if (m_state && !m_state->isReady()) {
+			m_state->setError(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+		}
+	}
+
+	std::shared_ptr<detail::FutureState<R> > m_state;   //!< Shared state
+};
+
+//! Template Class Future
+//!
+//! \brief
+//! Consuming side of an asynchronous result, move-only
+//!
+//! \note
+//! The result is either waited for with Get(), or handed to a continuation with Then(), which
+//! runs on the executor of the promise (e.g. the ThreadPool of ThreadPool::Submit) and results
+//! in a new future. Both consume the future. An error (an exception of the producing callable or a
+//! broken promise) is rethrown by Get() and passed on by Then() without calling the continuation.
+template<typename R>
+class BASIC_SERVICES_EXPORT Future {
+public:
+	using value_type = R;
+
+public:
+	//! Constructor of an invalid future
+	Future() noexcept = default;
+
+	//! Move constructor
+	Future(Future &&) noexcept = default;
+
+	//! Move assignment
+	Future &operator=(Future &&) noexcept = default;
+
+	//! Check validity of the instance
+	//!
+	//! \retval true - Future refers to a result
+	//! \retval false - Future is default constructed or consumed
+	explicit operator bool() const noexcept {
+		return nullptr != m_state;
+	}
+
+	//! Query whether the result or an error is available
+	bool isReady() const noexcept {
+		return m_state->isReady();
+	}
+
+	//! Wait until the result is available
+	void Wait() const {
+		m_state->wait();
+	}
+
+	//! Wait until the result is available or the timeout expired
+	//!
+	//! \param timeout - Maximum time to wait
+	//! \return Whether the result is available
+	template<typename Rep, typename Period>
+	bool Wait(std::chrono::duration<Rep, Period> const &timeout) const {
+		return m_state->waitUntil(std::chrono::steady_clock::now() + timeout);
+	}
+
+	//! Wait for the result and take it, consuming the future
+	//!
+	//! \note Rethrows the error the future completed with.
+	R Get() {
+		m_state->wait();
+		auto state = std::move(m_state);
+		if (state->getError()) {
+			std::rethrow_exception(state->getError());
+		}
+		if constexpr (!std::is_void<R>::value) {
+			return std::move(state->value());
+		}
+	}
+
+	//! Run a callable on the result once it is available, consuming the future
+	//!
+	//! \param func - Callable, invoked with the result (without arguments for Future<void>)
+	//! \return Future of the result of func
+	template<typename F, typename U = typename detail::ContinuationResult<R, std::decay_t<F> >::type>
+	Future<U> Then(F &&func) {
+		auto state = std::move(m_state);
+		// a continuation dropped by its executor breaks the promise and so the next future
+		Promise<U> promise(state->getExecutor());
+		Future<U> next = promise.getFuture();
+		detail::FutureState<R> &current = *state;
+
+		current.setContinuation(Task(
+				[state = std::move(state), promise = std::move(promise), func = std::forward<F>(func)]() mutable {
+					if (state->getError()) {
+						promise.setException(state->getError());
+						return;
+					}
+					promise.setValueWith([&]() -> U {
+						if constexpr (std::is_void<R>::value) {
+							return func();
+						} else {
+							return func(std::move(state->value()));
+						}
+					});
+				}));
+
+		return next;
+	}
+
+private:
+	template<typename>
+	friend class Promise;
+
+	template<typename>
+	friend class Future;
+
+	explicit Future(std::shared_ptr<detail::FutureState<R> > state)
+			: m_state(std::move(state)) {}
+
+	std::shared_ptr<detail::FutureState<R> > m_state;   //!< Shared state
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_FUTURE_H
@@ -0,0 +1,177 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_HISTOGRAM_H
+#define BASIC_SERVICES_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class Histogram
+//!
+//! \brief
+//! A log-linear (HDR style) histogram of unsigned values, e.g. latencies in nanoseconds
+//!
+//! \note
+//! Every power of two is split into kSubBuckets linear buckets, so a recorded value is
+//! reported with a relative error below 1/kSubBuckets over the whole 64 bit range.
+//! Values below kSubBuckets are recorded exactly. The class is not thread safe,
+//! see LatencyHistogram for concurrent recording.
+class BASIC_SERVICES_EXPORT Histogram {
+public:
+	static constexpr unsigned int kSubBucketBits = 3U;                     //!< log2 of buckets per power of two
+	static constexpr uint64_t kSubBuckets = uint64_t(1U) << kSubBucketBits; //!< Buckets per power of two
+	static constexpr std::size_t kBuckets = (64U - kSubBucketBits + 1U) * kSubBuckets; //!< Number of buckets
+
+	//! Bucket index of a value
+	static std::size_t bucketIndex(uint64_t value) noexcept {
+		if (value < kSubBuckets) {
+			return std::size_t(value);
+		}
+		unsigned int const shift = unsigned(63 - countLeadingZeros(value)) - kSubBucketBits;
+		return std::size_t((shift + 1U) * kSubBuckets + ((value >> shift) - kSubBuckets));
+	}
+
+	//! Highest value which is recorded into a bucket
+	static constexpr uint64_t bucketValue(std::size_t index) noexcept {
+		if (index < kSubBuckets) {
+			return index;
+		}
+		uint64_t const shift = index / kSubBuckets - 1U;
+		uint64_t const top = kSubBuckets + index % kSubBuckets;
+		return ((top + 1U) << shift) - 1U;
+	}
+
+	//! Record a value
+	//!
+	//! \param value - Value to record
+	//! \param count - Number of times the value occurred
+	void Record(uint64_t value, uint64_t count = 1U) noexcept {
+		m_counts[bucketIndex(value)] += count;
+		m_count += count;
+		m_sum += value * count;
+		m_min = (value < m_min) ? value : m_min;
+		m_max = (value > m_max) ? value : m_max;
+	}
+
+	//! Add all values of another histogram
+	void Merge(Histogram const &rhs) noexcept {
+		for (std::size_t i = 0; i < kBuckets; ++i) {
+			m_counts[i] += rhs.m_counts[i];
+		}
+		m_count += rhs.m_count;
+		m_sum += rhs.m_sum;
+		m_min = (rhs.m_min < m_min) ? rhs.m_min : m_min;
+		m_max = (rhs.m_max > m_max) ? rhs.m_max : m_max;
+	}
+
+	//! Number of recorded values
+	uint64_t Count() const noexcept { return m_count; }
+
+	//! Smallest recorded value (0 if empty)
+	uint64_t Min() const noexcept { return m_count ? m_min : 0U; }
+
+	//! Largest recorded value (0 if empty)
+	uint64_t Max() const noexcept { return m_max; }
+
+	//! Sum of recorded values
+	uint64_t Sum() const noexcept { return m_sum; }
+
+	//! Arithmetic mean of recorded values (0 if empty)
+	double Mean() const noexcept { return m_count ? double(m_sum) / double(m_count) : 0.0; }
+
+	//! Count of one bucket
+	uint64_t BucketCount(std::size_t index) const noexcept { return m_counts[index]; }
+
+	//! Value at a percentile
+	//!
+	//! \param percentile - Percentile within [0, 100]
+	//! \return Highest value of the bucket holding the percentile, clamped to the recorded maximum
+	uint64_t Percentile(double percentile) const noexcept {
+		if (0U == m_count) {
+			return 0U;
+		}
+		auto rank = uint64_t(percentile / 100.0 * double(m_count) + 0.5);
+		rank = (rank < 1U) ? 1U : ((rank > m_count) ? m_count : rank);
+
+		uint64_t seen = 0U;
+		for (std::size_t i = 0; i < kBuckets; ++i) {
+			seen += m_counts[i];
+			if (seen >= rank) {
+				uint64_t const value = bucketValue(i);
+				return (value < m_max) ? value : m_max;
+			}
+		}
+		return m_max;
+	}
+
+private:
+	friend class LatencyHistogram;
+
+	std::array<uint64_t, kBuckets> m_counts{};     //!< Counts per bucket
+	uint64_t m_count = 0U;                          //!< Number of recorded values
+	uint64_t m_sum = 0U;                            //!< Sum of recorded values
+	uint64_t m_min = std::numeric_limits<uint64_t>::max();  //!< Smallest recorded value
+	uint64_t m_max = 0U;                            //!< Largest recorded value
+};
+
+//! Class LatencyHistogram
+//!
+//! \brief
+//! A Histogram which may be recorded from several threads at once, using relaxed atomic counters.
+//! Snapshot() returns a plain Histogram which is consistent enough for monitoring.
+class BASIC_SERVICES_EXPORT LatencyHistogram : public noncopyable {
+public:
+	//! Record a value
+	void Record(uint64_t value) noexcept {
+		m_counts[Histogram::bucketIndex(value)].fetch_add(1U, std::memory_order_relaxed);
+		m_sum.fetch_add(value, std::memory_order_relaxed);
+
+		uint64_t max = m_max.load(std::memory_order_relaxed);
+		while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+		uint64_t min = m_min.load(std::memory_order_relaxed);
+		while (value < min && !m_min.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+	}
+
+	//! Take a snapshot of the recorded values
+	Histogram Snapshot() const noexcept {
+		Histogram histogram;
+		for (std::size_t i = 0; i < Histogram::kBuckets; ++i) {
+			histogram.m_counts[i] = m_counts[i].load(std::memory_order_relaxed);
+			histogram.m_count += histogram.m_counts[i];
+		}
+		histogram.m_sum = m_sum.load(std::memory_order_relaxed);
+		histogram.m_min = m_min.load(std::memory_order_relaxed);
+		histogram.m_max = m_max.load(std::memory_order_relaxed);
+		return histogram;
+	}
+
+	//! Forget all recorded values
+	void Reset() noexcept {
+		for (auto &count : m_counts) {
+			count.store(0U, std::memory_order_relaxed);
+		}
+		m_sum.store(0U, std::memory_order_relaxed);
+		m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+		m_max.store(0U, std::memory_order_relaxed);
+	}
+
+private:
+	std::array<std::atomic<uint64_t>, Histogram::kBuckets> m_counts{};   //!< Counts per bucket
+	std::atomic<uint64_t> m_sum{0U};                                    //!< Sum of recorded values
+	std::atomic<uint64_t> m_min{std::numeric_limits<uint64_t>::max()};  //!< Smallest recorded value
+	std::atomic<uint64_t> m_max{0U};                                    //!< Largest recorded value
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_HISTOGRAM_H
@@ -6,6 +6,7 @@
 #define BASIC_SERVICES_SERIAL_BUFFER_DEVICE_IMPL_H
 
 #include "serial-device-impl.h"
+#include "mirrored-ring-buffer.h"
 
 namespace basic {
 
@@ -15,45 +16,51 @@ namespace basic {
 
 class BASIC_SERVICES_NO_EXPORT SerialBufferDevice::Impl : public SerialDevice::Impl {
 private:
-	size_t const m_rx_size;                 //!< Size of internal rx buffer
-	std::unique_ptr<uint8_t[]> m_rx_buffer; //!< Internal rx buffer
-	size_t m_rx_index = 0;                  //!< Begin index of received data chunk
-	size_t m_rx_data_len = 0;               //!< Length of received data chunk
+	MirroredRingBuffer m_rx;                //!< Internal rx buffer, received data is always contiguous
 
 	using SerialDevice::Impl::ReadSome;
 
+	//! Synchronously read data from the serial device into the free part of the rx buffer
+	void Fill() {
+		Span<uint8_t> const free = m_rx.writable();
+		if (!free.empty()) {
+			m_rx.commit(ReadSome(free.data(), free.size()));
+		}
+	}
+
+	//! Return the received data
+	size_t Received(uint8_t const *&buffer) const noexcept {
+		buffer = m_rx.isEmpty() ? nullptr : m_rx.readable().data();
+		return m_rx.Size();
+	}
+
 public:
 	//! Constructor
 	Impl(char const *name, SerialDevice::Configuration const &config, size_t size)
-			: SerialDevice::Impl(name, config), m_rx_size(size),
-			  m_rx_buffer((0 != m_rx_size) ? std::make_unique<uint8_t[]>(m_rx_size) : nullptr) {}
+			: SerialDevice::Impl(name, config), m_rx(size) {}
 
 	//! Destructor
 	~Impl() = default;
 
-	bool IsValid() const noexcept { return SerialDevice::Impl::IsValid() && m_rx_buffer; }
+	bool IsValid() const noexcept { return SerialDevice::Impl::IsValid() && m_rx; }
 
 	size_t ReadSome(uint8_t const *&buffer) {
-		// no received data chunk
-		if (0 == m_rx_data_len) {
-			// synchronously read data from the serial device
-			m_rx_index = 0;
-			m_rx_data_len = ReadSome(&m_rx_buffer[m_rx_index], m_rx_size - m_rx_index);
+		// no received data
+		if (m_rx.isEmpty()) {
+			Fill();
 		}
-		// return the received data chunk
-		buffer = m_rx_data_len ? &m_rx_buffer[m_rx_index] : nullptr;
-		return m_rx_data_len;
+		// return the received data
+		return Received(buffer);
+	}
+
+	size_t ReadMore(uint8_t const *&buffer) {
+		// append to the data not removed yet, e.g. the start of a partial frame
+		Fill();
+		return Received(buffer);
 	}
 
 	void Remove(size_t size) noexcept {
-		if (m_rx_data_len > size) {
-			m_rx_data_len -= size;
-			m_rx_index += size;
-		} else {
-			// remove all data chunk in the buffer
-			m_rx_data_len = 0;
-			m_rx_index = 0;
-		}
+		m_rx.consume(size);
 	}
 };
 
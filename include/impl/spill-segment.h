@@ -0,0 +1,49 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_SPILL_SEGMENT_H
+#define BASIC_SERVICES_SPILL_SEGMENT_H
+
+#include <cstdint>
+#include <cstddef>
+
+#include "basic-services_export.h"
+
+namespace basic {
+
+namespace detail {
+
+//! Memory mapped segment file of a SpillStore
+struct BASIC_SERVICES_NO_EXPORT SpillSegment {
+	uint8_t *data = nullptr;    //!< Mapped file content
+	std::size_t size = 0;       //!< Size of the file
+	std::size_t used = 0;       //!< Number of written bytes
+	int fd = -1;                //!< Descriptor of the file on unix, kept to allocate its blocks again
+};
+
+//! Create and map a segment file, which is removed from the file system once unmapped
+//!
+//! \param directory - Directory of the file (nullptr selects the system temporary directory)
+//! \param segment - Segment to map, size gives the file size
+//! \retval true - Segment mapped, with all file blocks allocated
+//! \retval false - Failed to create, allocate (e.g. out of disk space) or map the file
+BASIC_SERVICES_NO_EXPORT bool MapSegment(char const *directory, SpillSegment &segment);
+
+//! Hand the pages of a segment back to the system, dropping its content
+//!
+//! \retval true - Segment may be written again
+//! \retval false - Segment lost file blocks which could not be allocated again, unmap it
+BASIC_SERVICES_NO_EXPORT bool DropSegment(SpillSegment &segment);
+
+//! Hand the pages of a written segment back to the system, keeping its content in the file
+BASIC_SERVICES_NO_EXPORT void EvictSegment(SpillSegment &segment);
+
+//! Unmap a segment, removing its file
+BASIC_SERVICES_NO_EXPORT void UnmapSegment(SpillSegment &segment);
+
+} // namespace detail
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_SPILL_SEGMENT_H
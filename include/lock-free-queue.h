@@ -0,0 +1,249 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_LOCK_FREE_QUEUE_H
+#define BASIC_SERVICES_LOCK_FREE_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <type_traits>
+
+#include "types.h"
+#include "wait-strategy.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class LockFreeQueue
+//!
+//! \brief
+//! A bounded multi-producer/multi-consumer queue without locks on the hot path.
+//!
+//! \note
+//! Values live in a preallocated power-of-two slot array. Every slot carries a sequence
+//! number telling producers and consumers whether it is free or filled for the current lap,
+//! so Push and Pop only contend on one atomic position each. Callers only wait when the
+//! queue is full (Push) or empty (Pop), as selected by the wait strategy; parked callers
+//! sleep on a condition variable which is only signalled while somebody is actually waiting.
+//!
+//! The interface mirrors basic::Queue, so call sites can switch with a type alias.
+//! Unlike basic::Queue the capacity is fixed at construction.
+template<typename T>
+class BASIC_SERVICES_EXPORT LockFreeQueue : public noncopyable {
+public:
+	using value_type = T;
+	using reference = T &;
+	using point_type = T *;
+	using const_reference = const T &;
+
+public:
+	//! Constructor
+	//!
+	//! \param cap - Capacity of the queue, rounded up to the next power of two (minimum 2)
+	//! \param strategy - How Push and Pop wait at the full/empty edges
+	explicit LockFreeQueue(std::size_t cap, WaitStrategy strategy = WaitStrategy::kSpinPark)
+			: m_mask(roundUpPowerOfTwo(cap < 2U ? 2U : cap) - 1U),
+			  m_slots(std::make_unique<Slot[]>(m_mask + 1U)), m_waitStrategy(strategy) {
+		for (std::size_t i = 0; i <= m_mask; ++i) {
+			m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	//! Destructor
+	~LockFreeQueue() {
+		while (tryPop([](value_type &&) {})) {}
+	}
+
+	//! Query whether queue is empty
+	//!
+	//! \retval true - The queue is empty
+	//! \retval false - The queue is no emtpy
+	bool isEmpty() const {
+		return 0U == Size();
+	}
+
+	//! Query whether queue is full
+	//!
+	//! \retval true - The queue is full
+	//! \retval false - The queue is no full
+	bool isFull() const {
+		return Size() >= getCapacity();
+	}
+
+	//! Query the current amount of values in the queue
+	//!
+	//! \note The value is a snapshot and may be stale under concurrent access
+	//! \return Number of values
+	std::size_t Size() const {
+		// dequeue first, it never passes the enqueue position loaded after it
+		std::size_t const dequeue = m_dequeuePos.load(std::memory_order_acquire);
+		std::size_t const size = m_enqueuePos.load(std::memory_order_acquire) - dequeue;
+		// producers may have refilled what consumers took since our dequeue snapshot
+		return (size > getCapacity()) ? getCapacity() : size;
+	}
+
+	//! Query the capacity of the queue
+	//! \return Capacity of the queue
+	std::size_t getCapacity() const {
+		return m_mask + 1U;
+	}
+
+	//! Try to push value into the queue
+	//!
+	//! \param value - Value to be pushed
+	//! \retval true - Value pushed
+	//! \retval false - Queue is full
+	bool TryPush(const_reference value) {
+		if (!tryPush(value)) {
+			return false;
+		}
+		m_notEmpty.Unpark();
+		return true;
+	}
+
+	//! Try to move value into the queue
+	//!
+	//! \param value - Value to be pushed, left untouched on failure
+	//! \retval true - Value pushed
+	//! \retval false - Queue is full
+	bool TryPush(value_type &&value) {
+		if (!tryPush(std::move(value))) {
+			return false;
+		}
+		m_notEmpty.Unpark();
+		return true;
+	}
+
+	//! Try to pop value out of the queue
+	//!
+	//! \param value - Receives the popped value
+	//! \retval true - Value popped
+	//! \retval false - Queue is empty
+	bool TryPop(reference value) {
+		if (!tryPop([&value](value_type &&v) { value = std::move(v); })) {
+			return false;
+		}
+		m_notFull.Unpark();
+		return true;
+	}
+
+	//! Push value into the queue
+	//!
+	//! \note
+	//! If the capacity is reached the caller blocks until a value is popped from the queue.
+	//! \param value - Value to be pushed
+	void Push(const_reference value) {
+		push(value);
+	}
+
+	//! Move value into the queue
+	//!
+	//! \note
+	//! If the capacity is reached the caller blocks until a value is popped from the queue.
+	//! \param value - Value to be pushed
+	void Push(value_type &&value) {
+		push(std::move(value));
+	}
+
+	//! Pop value out of the queue
+	//!
+	//! \note
+	//! If the queue is empty the caller blocks until a value is pushed into the queue.
+	//! \return Value be popped
+	value_type Pop() {
+		std::optional<value_type> value;
+		auto const ready = [this, &value] {
+			return tryPop([&value](value_type &&v) { value.emplace(std::move(v)); });
+		};
+		if (!spinWait(m_waitStrategy, ready)) {
+			m_notEmpty.Park(ready);
+		}
+		m_notFull.Unpark();
+
+		return std::move(*value);
+	}
+
+private:
+	//! Storage slot of one value
+	struct Slot {
+		std::atomic<std::size_t> m_sequence;    //!< Lap sequence of the slot
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage; //!< Raw value storage
+
+		point_type value() noexcept { return reinterpret_cast<point_type>(&m_storage); }
+	};
+
+	template<typename U>
+	void push(U &&value) {
+		auto const ready = [this, &value] { return tryPush(std::forward<U>(value)); };
+		if (!spinWait(m_waitStrategy, ready)) {
+			m_notFull.Park(ready);
+		}
+		m_notEmpty.Unpark();
+	}
+
+	//! Claim a free slot and construct the value in place (value is only consumed on success)
+	template<typename U>
+	bool tryPush(U &&value) {
+		std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Slot &slot = m_slots[pos & m_mask];
+			std::size_t const seq = slot.m_sequence.load(std::memory_order_acquire);
+			auto const diff = static_cast<std::ptrdiff_t>(seq - pos);
+			if (0 == diff) {
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+					::new(static_cast<void *>(slot.value())) value_type(std::forward<U>(value));
+					slot.m_sequence.store(pos + 1U, std::memory_order_release);
+					return true;
+				}
+			} else if (diff < 0) {
+				// slot still holds a value of the previous lap: queue is full
+				return false;
+			} else {
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	//! Claim a filled slot and hand its value over to the sink
+	template<typename Sink>
+	bool tryPop(Sink &&sink) {
+		std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Slot &slot = m_slots[pos & m_mask];
+			std::size_t const seq = slot.m_sequence.load(std::memory_order_acquire);
+			auto const diff = static_cast<std::ptrdiff_t>(seq - (pos + 1U));
+			if (0 == diff) {
+				if (m_dequeuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+					sink(std::move(*slot.value()));
+					slot.value()->~value_type();
+					slot.m_sequence.store(pos + m_mask + 1U, std::memory_order_release);
+					return true;
+				}
+			} else if (diff < 0) {
+				// slot not yet filled for this lap: queue is empty
+				return false;
+			} else {
+				pos = m_dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+private:
+	std::size_t const m_mask;               //!< Capacity - 1
+	std::unique_ptr<Slot[]> m_slots;        //!< Slot array
+
+	alignas(kCacheLineSize) std::atomic<std::size_t> m_enqueuePos{0U};  //!< Next position to push
+	alignas(kCacheLineSize) std::atomic<std::size_t> m_dequeuePos{0U};  //!< Next position to pop
+
+	WaitStrategy const m_waitStrategy;      //!< How blocked callers wait at the full/empty edges
+	alignas(kCacheLineSize) Parker m_notFull;   //!< Producers parked on a full queue
+	alignas(kCacheLineSize) Parker m_notEmpty;  //!< Consumers parked on an empty queue
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_LOCK_FREE_QUEUE_H
@@ -0,0 +1,104 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_MIRRORED_RING_BUFFER_H
+#define BASIC_SERVICES_MIRRORED_RING_BUFFER_H
+
+#include <cstdint>
+#include <cstddef>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class MirroredRingBuffer
+//!
+//! \brief
+//! A byte ring buffer whose memory is mapped twice back-to-back, so that every readable and every
+//! writable region is one contiguous span, also when it wraps around the end of the ring
+//!
+//! \note
+//! Data can therefore be read from a device straight into writable(), and a parser can consume a
+//! frame straddling the wrap from readable() without copying it together first. The capacity is
+//! rounded up to the page size (the allocation granularity on Windows). The class is not thread safe.
+class BASIC_SERVICES_EXPORT MirroredRingBuffer : public noncopyable {
+public:
+	//! Constructor
+	//!
+	//! \param size - Minimum capacity in bytes
+	explicit MirroredRingBuffer(std::size_t size);
+
+	//! Destructor
+	~MirroredRingBuffer();
+
+	//! Check validity of the instance
+	//!
+	//! \retval true - Buffer mapped
+	//! \retval false - Failed to map the buffer
+	explicit operator bool() const noexcept { return nullptr != m_data; }
+
+	//! Query the capacity in bytes
+	std::size_t getCapacity() const noexcept { return m_capacity; }
+
+	//! Query the number of readable bytes
+	std::size_t Size() const noexcept { return m_size; }
+
+	//! Query whether buffer is empty
+	bool isEmpty() const noexcept { return 0U == m_size; }
+
+	//! Query whether buffer is full
+	bool isFull() const noexcept { return m_capacity == m_size; }
+
+	//! All readable bytes as one contiguous region
+	Span<uint8_t const> readable() const noexcept {
+		return Span<uint8_t const>(m_data + m_head, m_size);
+	}
+
+	//! All free bytes as one contiguous region, to be published with commit()
+	Span<uint8_t> writable() noexcept {
+		std::size_t const tail = m_head + m_size;
+		return Span<uint8_t>(m_data + (tail < m_capacity ? tail : tail - m_capacity), m_capacity - m_size);
+	}
+
+	//! Remove bytes from the front of the readable region
+	//!
+	//! \param size - Number of bytes to remove, at most Size()
+	void consume(std::size_t size) noexcept {
+		size = (size < m_size) ? size : m_size;
+		m_size -= size;
+		m_head += size;
+		if (m_head >= m_capacity) {
+			m_head -= m_capacity;
+		}
+		if (0U == m_size) {
+			// restart at the front, keeping the touched pages hot
+			m_head = 0U;
+		}
+	}
+
+	//! Publish bytes written to the front of the writable region
+	//!
+	//! \param size - Number of bytes written, at most the size of writable()
+	void commit(std::size_t size) noexcept {
+		m_size += (size < m_capacity - m_size) ? size : m_capacity - m_size;
+	}
+
+	//! Remove all bytes
+	void clear() noexcept {
+		m_head = 0U;
+		m_size = 0U;
+	}
+
+private:
+	uint8_t *m_data = nullptr;      //!< First of the two mappings
+	std::size_t m_capacity = 0U;    //!< Size of one mapping
+	std::size_t m_head = 0U;        //!< Offset of the first readable byte
+	std::size_t m_size = 0U;        //!< Number of readable bytes
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_MIRRORED_RING_BUFFER_H
@@ -0,0 +1,369 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_MULTICAST_RING_H
+#define BASIC_SERVICES_MULTICAST_RING_H
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "wait-strategy.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class Sequence
+//!
+//! \brief
+//! Progress counter of a producer or consumer of a MulticastRing, on a cache line of its own
+class BASIC_SERVICES_EXPORT Sequence : public noncopyable {
+public:
+	//! Value of a sequence before the first entry was processed
+	static constexpr int64_t kInitial = -1;
+
+	//! Constructor
+	explicit Sequence(int64_t value = kInitial)
+			: m_value(value) {}
+
+	//! Query the sequence
+	int64_t get() const noexcept {
+		return m_value.load(std::memory_order_acquire);
+	}
+
+	//! Set the sequence, publishing all writes before
+	void set(int64_t value) noexcept {
+		m_value.store(value, std::memory_order_release);
+	}
+
+	//! Minimum of several sequences
+	static int64_t minimum(std::vector<Sequence const *> const &sequences, int64_t initial) noexcept {
+		for (Sequence const *sequence : sequences) {
+			initial = std::min(initial, sequence->get());
+		}
+		return initial;
+	}
+
+private:
+	alignas(kCacheLineSize) std::atomic<int64_t> m_value;  //!< Last processed sequence
+};
+
+//! How producers claim entries of a MulticastRing
+enum class ProducerType : uint8_t {
+	kSingle,    //!< one producer thread, claiming is a plain increment
+	kMulti      //!< several producer threads, claiming is an atomic increment
+};
+
+template<typename T>
+class SequenceBarrier;
+
+//! Template Class MulticastRing
+//!
+//! \brief
+//! A preallocated ring of entries which is written once and read by several consumers (Disruptor style)
+//!
+//! \note
+//! Producers claim sequence numbers, fill the entries in place and publish them. Every consumer
+//! tracks its own Sequence and reads the published entries in place through a SequenceBarrier,
+//! which may also wait for other consumers, so consumers can form a dependency graph (e.g. the
+//! business logic only runs on entries the journaller has processed). The producers never
+//! overwrite entries the gating sequences (the last consumers of the graph) have not passed yet.
+//! There are no locks and no copies; waiting follows the wait strategy, where parked threads are
+//! only woken up while somebody actually sleeps.
+//!
+//! \tparam T - Entry type, default constructed once and then reused
+template<typename T>
+class BASIC_SERVICES_EXPORT MulticastRing : public noncopyable {
+public:
+	using value_type = T;
+	using reference = T &;
+
+public:
+	//! Constructor
+	//!
+	//! \param size - Number of entries, rounded up to the next power of two
+	//! \param type - Whether one or several threads publish
+	//! \param strategy - How producers and consumers wait
+	explicit MulticastRing(std::size_t size, ProducerType type = ProducerType::kSingle,
+	                       WaitStrategy strategy = WaitStrategy::kSpinPark)
+			: m_size(int64_t(roundUpPowerOfTwo(size < 2U ? 2U : size))), m_mask(m_size - 1),
+			  m_shift(63 - countLeadingZeros(uint64_t(m_size))), m_type(type), m_waitStrategy(strategy),
+			  m_entries(std::make_unique<value_type[]>(std::size_t(m_size))) {
+		if (ProducerType::kMulti == m_type) {
+			m_available = std::make_unique<std::atomic<int64_t>[]>(std::size_t(m_size));
+			for (int64_t i = 0; i < m_size; ++i) {
+				m_available[i].store(-1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	//! Destructor
+	~MulticastRing() = default;
+
+	//! Query the number of entries
+	std::size_t getCapacity() const noexcept {
+		return std::size_t(m_size);
+	}
+
+	//! Query the wait strategy
+	WaitStrategy getWaitStrategy() const noexcept {
+		return m_waitStrategy;
+	}
+
+	//! Add the sequences of consumers which producers must not overtake
+	//!
+	//! \note Call before the first entry is claimed.
+	void addGatingSequences(std::initializer_list<Sequence const *> sequences) {
+		m_gating.insert(m_gating.end(), sequences.begin(), sequences.end());
+	}
+
+	//! Create a barrier for a consumer
+	//!
+	//! \param dependencies - Sequences of consumers which must have processed an entry first
+	SequenceBarrier<T> newBarrier(std::initializer_list<Sequence const *> dependencies = {}) {
+		return SequenceBarrier<T>(*this, dependencies);
+	}
+
+	//! Access the entry of a sequence
+	reference operator[](int64_t sequence) noexcept {
+		return m_entries[std::size_t(sequence & m_mask)];
+	}
+
+	//! Claim the next entries, waiting while the ring is full
+	//!
+	//! \param count - Number of entries to claim, at most the capacity
+	//! \return Highest claimed sequence, the claimed ones are [result - count + 1, result]
+	int64_t Claim(int64_t count = 1) {
+		int64_t next;
+		if (ProducerType::kSingle == m_type) {
+			next = m_claimed.load(std::memory_order_relaxed) + count;
+			m_claimed.store(next, std::memory_order_relaxed);
+		} else {
+			next = m_claimed.fetch_add(count, std::memory_order_relaxed) + count;
+		}
+
+		int64_t const wrapPoint = next - m_size;
+		if (wrapPoint > m_gatingCache.load(std::memory_order_acquire)) {
+			int64_t gating = 0;
+			auto const ready = [this, wrapPoint, &gating] {
+				gating = Sequence::minimum(m_gating, m_cursor.load(std::memory_order_acquire));
+				return wrapPoint <= gating;
+			};
+			if (!spinWait(m_waitStrategy, ready)) {
+				m_progress.Park(ready);
+			}
+			// release, other producers rely on the cached value as if they had read the consumers
+			m_gatingCache.store(gating, std::memory_order_release);
+		}
+
+		return next;
+	}
+
+	//! Publish claimed entries to the consumers
+	//!
+	//! \param low - Lowest sequence to publish
+	//! \param high - Highest sequence to publish
+	void Publish(int64_t low, int64_t high) {
+		if (ProducerType::kSingle == m_type) {
+			m_cursor.store(high, std::memory_order_release);
+		} else {
+			for (int64_t sequence = low; sequence <= high; ++sequence) {
+				m_available[sequence & m_mask].store(sequence >> m_shift, std::memory_order_release);
+			}
+			int64_t cursor = m_cursor.load(std::memory_order_relaxed);
+			while (cursor < high && !m_cursor.compare_exchange_weak(cursor, high, std::memory_order_release)) {}
+		}
+		signal();
+	}
+
+	//! Publish a claimed entry to the consumers
+	void Publish(int64_t sequence) {
+		Publish(sequence, sequence);
+	}
+
+	//! Claim an entry, fill it and publish it
+	//!
+	//! \param translator - Called with the entry and its sequence to fill the entry in place
+	//! \return Sequence of the entry
+	template<typename Translator>
+	int64_t PublishEvent(Translator &&translator) {
+		int64_t const sequence = Claim();
+		translator((*this)[sequence], sequence);
+		Publish(sequence);
+		return sequence;
+	}
+
+	//! Highest sequence published so far
+	int64_t getCursor() const noexcept {
+		return m_cursor.load(std::memory_order_acquire);
+	}
+
+	//! Wake up waiting producers and consumers after progress (consumers call it after advancing)
+	void signal() {
+		if (isParking(m_waitStrategy)) {
+			m_progress.UnparkAll();
+		}
+	}
+
+private:
+	friend class SequenceBarrier<T>;
+
+	//! Highest sequence for which all entries from low on are published
+	int64_t highestPublished(int64_t low, int64_t available) const noexcept {
+		if (ProducerType::kSingle == m_type) {
+			return available;
+		}
+		for (int64_t sequence = low; sequence <= available; ++sequence) {
+			if (m_available[sequence & m_mask].load(std::memory_order_acquire) != (sequence >> m_shift)) {
+				return sequence - 1;
+			}
+		}
+		return available;
+	}
+
+private:
+	int64_t const m_size;                               //!< Number of entries
+	int64_t const m_mask;                               //!< m_size - 1
+	int const m_shift;                                  //!< log2(m_size)
+	ProducerType const m_type;                          //!< Whether one or several threads publish
+	WaitStrategy const m_waitStrategy;                  //!< How producers and consumers wait
+	std::unique_ptr<value_type[]> m_entries;            //!< Entries
+	std::unique_ptr<std::atomic<int64_t>[]> m_available;    //!< Round of the last publish per entry (kMulti)
+	std::vector<Sequence const *> m_gating;             //!< Sequences producers must not overtake
+
+	alignas(kCacheLineSize) std::atomic<int64_t> m_claimed{Sequence::kInitial};     //!< Highest claimed sequence
+	std::atomic<int64_t> m_gatingCache{Sequence::kInitial};                         //!< Last seen minimum gating sequence
+	alignas(kCacheLineSize) std::atomic<int64_t> m_cursor{Sequence::kInitial};      //!< Highest published sequence
+	alignas(kCacheLineSize) Parker m_progress;          //!< Parked producers and consumers
+};
+
+//! Template Class SequenceBarrier
+//!
+//! \brief
+//! Lets a consumer wait until entries are published and processed by the consumers it depends on
+template<typename T>
+class BASIC_SERVICES_EXPORT SequenceBarrier {
+public:
+	//! Constructor
+	//!
+	//! \param ring - Ring to consume
+	//! \param dependencies - Sequences of consumers which must have processed an entry first
+	SequenceBarrier(MulticastRing<T> &ring, std::initializer_list<Sequence const *> dependencies)
+			: m_ring(&ring), m_dependencies(dependencies) {}
+
+	//! Move constructor
+	SequenceBarrier(SequenceBarrier &&rhs) noexcept
+			: m_ring(rhs.m_ring), m_dependencies(std::move(rhs.m_dependencies)),
+			  m_alerted(rhs.m_alerted.load(std::memory_order_relaxed)) {}
+
+	//! Wait until an entry is available
+	//!
+	//! \param sequence - Sequence to wait for
+	//! \return Highest available sequence (at least sequence), or less than sequence once alerted
+	int64_t WaitFor(int64_t sequence) {
+		int64_t available = Sequence::kInitial;
+		auto const ready = [this, sequence, &available] {
+			available = Sequence::minimum(m_dependencies, m_ring->getCursor());
+			if (available >= sequence) {
+				// with several producers, later entries may be published before earlier ones
+				available = m_ring->highestPublished(sequence, available);
+			}
+			return available >= sequence || isAlerted();
+		};
+		if (!spinWait(m_ring->getWaitStrategy(), ready)) {
+			m_ring->m_progress.Park(ready);
+		}
+
+		return available;
+	}
+
+	//! Stop waiting consumers
+	void Alert() {
+		m_alerted.store(true, std::memory_order_release);
+		m_ring->m_progress.UnparkAll();
+	}
+
+	//! Query whether the barrier was alerted
+	bool isAlerted() const noexcept {
+		return m_alerted.load(std::memory_order_acquire);
+	}
+
+	//! Clear the alert
+	void clearAlert() noexcept {
+		m_alerted.store(false, std::memory_order_release);
+	}
+
+private:
+	MulticastRing<T> *m_ring;                       //!< Consumed ring
+	std::vector<Sequence const *> m_dependencies;   //!< Consumers which must process an entry first
+	std::atomic<bool> m_alerted{false};             //!< Consumers asked to stop
+};
+
+//! Template Class BatchConsumer
+//!
+//! \brief
+//! Runs a handler on every entry of a MulticastRing, processing all available entries in one batch
+//!
+//! \note
+//! Run() loops on the calling thread until Halt() is called, handing out every entry in place to
+//! handler(entry, sequence, endOfBatch) and advancing its sequence once per batch.
+//!
+//! \tparam T - Entry type
+//! \tparam Handler - Callable as handler(T &, int64_t, bool)
+template<typename T, typename Handler>
+class BASIC_SERVICES_EXPORT BatchConsumer : public noncopyable {
+public:
+	//! Constructor
+	//!
+	//! \param ring - Ring to consume
+	//! \param barrier - Barrier of the consumer, see MulticastRing::newBarrier
+	//! \param handler - Entry handler
+	BatchConsumer(MulticastRing<T> &ring, SequenceBarrier<T> &&barrier, Handler handler)
+			: m_ring(ring), m_barrier(std::move(barrier)), m_handler(std::move(handler)) {}
+
+	//! Sequence of the consumer, to be used as dependency or gating sequence
+	Sequence const &getSequence() const noexcept {
+		return m_sequence;
+	}
+
+	//! Process entries until Halt() is called
+	void Run() {
+		int64_t next = m_sequence.get() + 1;
+		while (!m_barrier.isAlerted()) {
+			int64_t const available = m_barrier.WaitFor(next);
+			if (available < next) {
+				continue;
+			}
+
+			for (; next <= available; ++next) {
+				m_handler(m_ring[next], next, next == available);
+			}
+			m_sequence.set(available);
+			m_ring.signal();
+		}
+		m_barrier.clearAlert();
+	}
+
+	//! Make Run() return after the current batch
+	void Halt() {
+		m_barrier.Alert();
+	}
+
+private:
+	MulticastRing<T> &m_ring;           //!< Consumed ring
+	SequenceBarrier<T> m_barrier;       //!< Barrier of the consumer
+	Handler m_handler;                  //!< Entry handler
+	Sequence m_sequence;                //!< Last processed sequence
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_MULTICAST_RING_H
@@ -0,0 +1,88 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_NUMA_THREAD_POOL_H
+#define BASIC_SERVICES_NUMA_THREAD_POOL_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "noncopyable.h"
+#include "thread-pool.h"
+#include "cpu-topology.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class NumaThreadPool
+//!
+//! \brief
+//! One ThreadPool per NUMA node, with the workers of each pinned to the cores of their node
+//!
+//! \note
+//! Tasks run on the node they are submitted to, so data a task allocates and touches first
+//! stays in the memory of that node, and later tasks on the node find it there. Run() without a
+//! node picks the node of the calling thread.
+class BASIC_SERVICES_EXPORT NumaThreadPool : public noncopyable, public Executor {
+public:
+	using Task = ThreadPool::Task;
+
+public:
+	//! Constructor
+	//!
+	//! \param name - Name of the pool, the node pools are named name/node
+	//! \param capacity - Maximum number of pending tasks per node (0 means unlimited)
+	//! \param strategy - How idle workers wait for tasks
+	//! \param scheduling - How tasks are distributed over the workers of a node
+	NumaThreadPool(std::string const &name, uint16_t capacity, WaitStrategy strategy = WaitStrategy::kBlock,
+	               Scheduling scheduling = Scheduling::kShared);
+
+	//! Destructor
+	~NumaThreadPool();
+
+	//! Start the node pools
+	//!
+	//! \param threadsPerNode - Number of workers per node, 0 for one worker per core
+	void Start(unsigned int threadsPerNode = 0);
+
+	//! Stop the node pools
+	void Stop();
+
+	//! Query the number of nodes
+	std::size_t getNodeCount() const;
+
+	//! Retrieve the topology the pools are placed by
+	CpuTopology const &getTopology() const;
+
+	//! Retrieve the pool of a node
+	ThreadPool &getPool(std::size_t node);
+
+	//! Query the number of workers of all nodes which failed to pin to their node and run unpinned
+	std::size_t getUnpinnedCount() const;
+
+	//! Push a task into the pool of a node
+	void Run(std::size_t node, Task task);
+
+	//! Push a task into the pool of the node the calling thread runs on
+	void Run(Task task);
+
+	//! Push a task into the pool of the node the calling thread runs on, see Executor
+	void Execute(Task task) override;
+
+	//! Push a callable into the pool of a node and get a future of its result
+	template<typename F, typename... Args>
+	auto Submit(std::size_t node, F &&func, Args &&... args) {
+		return getPool(node).Submit(std::forward<F>(func), std::forward<Args>(args)...);
+	}
+
+private:
+	CpuTopology const m_topology;                       //!< Placement of the node pools
+	std::vector<std::unique_ptr<ThreadPool> > m_pools;  //!< Pool per node
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_NUMA_THREAD_POOL_H
@@ -0,0 +1,307 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_PARALLEL_H
+#define BASIC_SERVICES_PARALLEL_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <exception>
+#include <algorithm>
+#include <functional>
+
+#include "thread-pool.h"
+#include "wait-strategy.h"
+
+namespace basic {
+
+namespace detail {
+
+//! Split of an index range into chunks which shrink towards the end (guided self-scheduling)
+//!
+//! \note
+//! Every chunk takes 1 / (2 * participants) of what is left, but at least the grain, so early
+//! chunks are large and cheap to hand out while the small last ones even out the finish.
+class BASIC_SERVICES_NO_EXPORT ChunkPlan {
+public:
+	//! Constructor
+	//!
+	//! \param count - Number of indices
+	//! \param participants - Number of threads taking part
+	//! \param grain - Minimum chunk size, 0 selects count / (64 * participants)
+	ChunkPlan(std::size_t count, std::size_t participants, std::size_t grain) {
+		participants = std::max<std::size_t>(1U, participants);
+		if (0U == grain) {
+			grain = count / (64U * participants);
+		}
+		grain = std::max<std::size_t>(1U, grain);
+
+		m_bounds.push_back(0U);
+		for (std::size_t position = 0U; position < count;) {
+			std::size_t const remaining = count - position;
+			position += std::min(remaining, std::max(grain, remaining / (2U * participants)));
+			m_bounds.push_back(position);
+		}
+	}
+
+	//! Number of chunks
+	std::size_t size() const noexcept {
+		return m_bounds.size() - 1U;
+	}
+
+	//! First index of a chunk
+	std::size_t begin(std::size_t chunk) const noexcept {
+		return m_bounds[chunk];
+	}
+
+	//! Index behind a chunk
+	std::size_t end(std::size_t chunk) const noexcept {
+		return m_bounds[chunk + 1U];
+	}
+
+private:
+	std::vector<std::size_t> m_bounds;  //!< Chunk boundaries, starting with 0 and ending with count
+};
+
+//! Progress of a ForEachChunk call, shared with helper tasks which may start after it returned
+struct BASIC_SERVICES_NO_EXPORT ChunkProgress {
+	explicit ChunkProgress(std::size_t chunks)
+			: m_chunks(chunks) {}
+
+	std::size_t const m_chunks;             //!< Number of chunks
+	std::atomic<std::size_t> m_next{0U};    //!< Next chunk to hand out
+	std::atomic<std::size_t> m_done{0U};    //!< Number of processed chunks
+	std::atomic<bool> m_failed{false};      //!< Whether a chunk threw, later chunks are skipped
+	std::exception_ptr m_error;             //!< First exception, written before its chunk counts as done
+	Parker m_finished;                      //!< Caller waiting for the last chunk
+};
+
+//! Run body(chunk, begin, end) for every chunk of the plan on the pool and the calling thread
+//!
+//! \note
+//! Helper tasks only touch the plan and the body after claiming a chunk, and the caller only
+//! returns once every claimed chunk is processed, so late helpers find nothing left to do.
+//! If body throws, the remaining chunks are skipped and the first exception is rethrown on the
+//! calling thread once every chunk is accounted for, so nothing still refers to body then.
+//! Helpers are queued with ThreadPool::Run(), which never blocks a worker of the pool on its
+//! capacity, so calls nested in a body cannot deadlock a bounded pool.
+template<typename Body>
+void ForEachChunk(ThreadPool &pool, ChunkPlan const &plan, Body const &body) {
+	std::size_t const chunks = plan.size();
+	std::size_t const helpers = std::min(pool.getThreadCount(), chunks - std::min<std::size_t>(chunks, 1U));
+	if (0U == helpers) {
+		for (std::size_t chunk = 0U; chunk < chunks; ++chunk) {
+			body(chunk, plan.begin(chunk), plan.end(chunk));
+		}
+		return;
+	}
+
+	auto const progress = std::make_shared<ChunkProgress>(chunks);
+	auto const participate = [&plan, &body](ChunkProgress &state) {
+		for (std::size_t chunk = state.m_next.fetch_add(1U, std::memory_order_relaxed); chunk < state.m_chunks;
+		     chunk = state.m_next.fetch_add(1U, std::memory_order_relaxed)) {
+			if (!state.m_failed.load(std::memory_order_relaxed)) {
+				try {
+					body(chunk, plan.begin(chunk), plan.end(chunk));
+				} catch (...) {
+					if (!state.m_failed.exchange(true, std::memory_order_relaxed)) {
+						state.m_error = std::current_exception();
+					}
+				}
+			}
+			if (state.m_done.fetch_add(1U, std::memory_order_acq_rel) + 1U == state.m_chunks) {
+				state.m_finished.UnparkAll();
+			}
+		}
+	};
+
+	for (std::size_t i = 0U; i < helpers; ++i) {
+		pool.Run([progress, participate] { participate(*progress); });
+	}
+	participate(*progress);
+
+	auto const finished = [&progress] {
+		return progress->m_done.load(std::memory_order_acquire) == progress->m_chunks;
+	};
+	if (!spinWait(WaitStrategy::kSpinPark, finished)) {
+		progress->m_finished.Park(finished);
+	}
+	if (progress->m_error) {
+		std::rethrow_exception(progress->m_error);
+	}
+}
+
+//! Number of threads taking part in an algorithm on the pool
+inline std::size_t participants(ThreadPool const &pool) {
+	return pool.getThreadCount() + 1U;
+}
+
+} // namespace detail
+
+//! Call func(i) for every index i of [first, last) on the pool, the calling thread takes part
+//!
+//! \param pool - Thread pool
+//! \param first - First index
+//! \param last - Index behind the last one
+//! \param func - Callable, invoked concurrently
+//! \param grain - Minimum number of indices per chunk, 0 selects it automatically
+template<typename Index, typename F>
+void ParallelFor(ThreadPool &pool, Index first, Index last, F &&func, std::size_t grain = 0U) {
+	if (!(first < last)) {
+		return;
+	}
+	detail::ChunkPlan const plan(std::size_t(last - first), detail::participants(pool), grain);
+	detail::ForEachChunk(pool, plan, [first, &func](std::size_t, std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			func(Index(first + Index(i)));
+		}
+	});
+}
+
+//! Call func(begin, end) for chunks covering [first, last) on the pool, the calling thread takes part
+//!
+//! \param pool - Thread pool
+//! \param first - First index
+//! \param last - Index behind the last one
+//! \param func - Callable, invoked concurrently with the bounds of a chunk
+//! \param grain - Minimum number of indices per chunk, 0 selects it automatically
+template<typename Index, typename F>
+void ParallelForRange(ThreadPool &pool, Index first, Index last, F &&func, std::size_t grain = 0U) {
+	if (!(first < last)) {
+		return;
+	}
+	detail::ChunkPlan const plan(std::size_t(last - first), detail::participants(pool), grain);
+	detail::ForEachChunk(pool, plan, [first, &func](std::size_t, std::size_t begin, std::size_t end) {
+		func(Index(first + Index(begin)), Index(first + Index(end)));
+	});
+}
+
+//! Write op(x) of every element x of [first, last) to out, like std::transform
+//!
+//! \return Iterator behind the last written element
+template<typename InputIt, typename OutputIt, typename UnaryOp>
+OutputIt ParallelTransform(ThreadPool &pool, InputIt first, InputIt last, OutputIt out, UnaryOp op,
+                           std::size_t grain = 0U) {
+	auto const count = std::size_t(std::distance(first, last));
+	detail::ChunkPlan const plan(count, detail::participants(pool), grain);
+	detail::ForEachChunk(pool, plan, [first, out, &op](std::size_t, std::size_t begin, std::size_t end) {
+		auto input = std::next(first, std::ptrdiff_t(begin));
+		auto output = std::next(out, std::ptrdiff_t(begin));
+		for (std::size_t i = begin; i < end; ++i, ++input, ++output) {
+			*output = op(*input);
+		}
+	});
+	return std::next(out, std::ptrdiff_t(count));
+}
+
+//! Combine init and all elements of [first, last) with op
+//!
+//! \note op must be associative; chunks are reduced concurrently and combined in order.
+//!
+//! \return Result of the reduction, init if the range is empty
+template<typename InputIt, typename T, typename BinaryOp = std::plus<> >
+T ParallelReduce(ThreadPool &pool, InputIt first, InputIt last, T init, BinaryOp op = BinaryOp(),
+                 std::size_t grain = 0U) {
+	detail::ChunkPlan const plan(std::size_t(std::distance(first, last)), detail::participants(pool), grain);
+	std::vector<std::optional<T> > partials(plan.size());
+	detail::ForEachChunk(pool, plan, [first, &op, &partials](std::size_t chunk, std::size_t begin, std::size_t end) {
+		auto input = std::next(first, std::ptrdiff_t(begin));
+		T partial = *input;
+		for (std::size_t i = begin + 1U; i < end; ++i) {
+			partial = op(std::move(partial), *++input);
+		}
+		partials[chunk].emplace(std::move(partial));
+	});
+
+	for (auto &partial : partials) {
+		init = op(std::move(init), std::move(*partial));
+	}
+	return init;
+}
+
+//! Write the inclusive prefix combinations of [first, last) to out, like std::inclusive_scan
+//!
+//! \note
+//! op must be associative. The chunk totals are computed concurrently first, then every chunk
+//! is scanned concurrently starting from the combination of the totals before it.
+//!
+//! \return Iterator behind the last written element
+template<typename InputIt, typename OutputIt, typename BinaryOp = std::plus<> >
+OutputIt ParallelInclusiveScan(ThreadPool &pool, InputIt first, InputIt last, OutputIt out,
+                               BinaryOp op = BinaryOp(), std::size_t grain = 0U) {
+	using T = typename std::iterator_traits<InputIt>::value_type;
+
+	auto const count = std::size_t(std::distance(first, last));
+	detail::ChunkPlan const plan(count, detail::participants(pool), grain);
+	std::vector<std::optional<T> > carries(plan.size());
+	detail::ForEachChunk(pool, plan, [first, &op, &carries](std::size_t chunk, std::size_t begin, std::size_t end) {
+		if (chunk + 1U == carries.size()) {
+			// the total of the last chunk is never needed
+			return;
+		}
+		auto input = std::next(first, std::ptrdiff_t(begin));
+		T total = *input;
+		for (std::size_t i = begin + 1U; i < end; ++i) {
+			total = op(std::move(total), *++input);
+		}
+		carries[chunk + 1U].emplace(std::move(total));
+	});
+
+	// turn the totals into the combination of everything before each chunk
+	for (std::size_t chunk = 2U; chunk < carries.size(); ++chunk) {
+		carries[chunk] = op(*carries[chunk - 1U], std::move(*carries[chunk]));
+	}
+
+	detail::ForEachChunk(pool, plan, [first, out, &op, &carries](std::size_t chunk, std::size_t begin, std::size_t end) {
+		auto input = std::next(first, std::ptrdiff_t(begin));
+		auto output = std::next(out, std::ptrdiff_t(begin));
+		T sum = carries[chunk] ? op(*carries[chunk], *input) : T(*input);
+		*output = sum;
+		for (std::size_t i = begin + 1U; i < end; ++i) {
+			sum = op(std::move(sum), *++input);
+			*++output = sum;
+		}
+	});
+	return std::next(out, std::ptrdiff_t(count));
+}
+
+//! Sort [first, last) with comp, like std::sort
+//!
+//! \note
+//! Equal blocks are sorted concurrently, then merged pairwise in concurrent rounds.
+template<typename RandomIt, typename Compare = std::less<> >
+void ParallelSort(ThreadPool &pool, RandomIt first, RandomIt last, Compare comp = Compare(),
+                  std::size_t grain = 0U) {
+	auto const count = std::size_t(last - first);
+	std::size_t blocks = 1U;
+	while (blocks < 2U * detail::participants(pool) && count / (2U * blocks) >= std::max<std::size_t>(grain, 1024U)) {
+		blocks *= 2U;
+	}
+	if (1U == blocks) {
+		std::sort(first, last, comp);
+		return;
+	}
+
+	auto const bound = [first, count, blocks](std::size_t block) {
+		return first + std::ptrdiff_t(count * block / blocks);
+	};
+	ParallelFor(pool, std::size_t(0U), blocks, [&bound, &comp](std::size_t block) {
+		std::sort(bound(block), bound(block + 1U), comp);
+	}, 1U);
+
+	for (std::size_t width = 1U; width < blocks; width *= 2U) {
+		ParallelFor(pool, std::size_t(0U), blocks / (2U * width), [&bound, &comp, width](std::size_t pair) {
+			std::size_t const block = 2U * width * pair;
+			std::inplace_merge(bound(block), bound(block + width), bound(block + 2U * width), comp);
+		}, 1U);
+	}
+}
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_PARALLEL_H
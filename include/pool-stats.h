@@ -0,0 +1,277 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_POOL_STATS_H
+#define BASIC_SERVICES_POOL_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "types.h"
+#include "histogram.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! What a ThreadPool measures
+enum class MetricsMode : uint8_t {
+	kOff,       //!< nothing (default)
+	kSampled,   //!< counters and idle times, queue wait and run time of every n-th task
+	kFull       //!< counters and idle times, queue wait and run time of every task
+};
+
+//! Snapshot of the statistics of one worker slot
+struct WorkerStatsSnapshot {
+	uint64_t tasks = 0U;                    //!< Number of run tasks
+	std::chrono::nanoseconds busy{0};       //!< Time the worker was alive and not waiting for tasks
+	std::chrono::nanoseconds idle{0};       //!< Time the worker waited for tasks
+};
+
+//! Snapshot of the statistics of a thread pool
+struct PoolStatsSnapshot {
+	uint64_t submitted = 0U;                //!< Number of queued tasks
+	uint64_t completed = 0U;                //!< Number of run tasks
+	std::size_t queueDepth = 0U;            //!< Tasks queued now, including work stealing deques
+	std::size_t maxQueueDepth = 0U;         //!< Highest depth of the shared queue
+	std::chrono::nanoseconds elapsed{0};    //!< Time since start or reset
+	double tasksPerSecond = 0.0;            //!< Completed tasks per second of elapsed
+	Histogram queueWait;                    //!< Time timed tasks spent queued [ns]
+	Histogram runTime;                      //!< Time timed tasks ran [ns]
+	std::vector<WorkerStatsSnapshot> workers;   //!< Statistics by worker slot
+};
+
+namespace detail {
+
+//! Statistics of one worker slot, written by its worker only and aligned to a cache line of its own
+class BASIC_SERVICES_NO_EXPORT WorkerStats : public noncopyable {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	//! A worker started in the slot
+	void onStart(Clock::time_point now) noexcept {
+		m_started.store(ticks(now), std::memory_order_relaxed);
+	}
+
+	//! The worker of the slot stopped
+	void onStop(Clock::time_point now) noexcept {
+		onBusy(now);
+		int64_t const started = m_started.exchange(0, std::memory_order_relaxed);
+		m_alive.fetch_add(ticks(now) - started, std::memory_order_relaxed);
+	}
+
+	//! The worker starts waiting for tasks, nothing if it already waits
+	void onIdle(Clock::time_point now) noexcept {
+		if (!m_isIdle) {
+			m_isIdle = true;
+			m_idleSince.store(ticks(now), std::memory_order_relaxed);
+		}
+	}
+
+	//! Query whether the worker waits for tasks
+	bool isIdle() const noexcept {
+		return m_isIdle;
+	}
+
+	//! The worker got a task after waiting, nothing if it did not wait
+	void onBusy(Clock::time_point now) noexcept {
+		if (m_isIdle) {
+			m_isIdle = false;
+			int64_t const since = m_idleSince.exchange(0, std::memory_order_relaxed);
+			m_idle.fetch_add(ticks(now) - since, std::memory_order_relaxed);
+		}
+	}
+
+	//! The worker ran a task
+	void onTask() noexcept {
+		m_tasks.store(m_tasks.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+	}
+
+	//! The worker pushed a task to its own deque
+	void onSpawn() noexcept {
+		m_spawned.store(m_spawned.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+	}
+
+	//! Query the number of tasks pushed to the own deque since the last reset
+	uint64_t getSpawned() const noexcept {
+		return m_spawned.load(std::memory_order_relaxed) - m_base.spawned.load(std::memory_order_relaxed);
+	}
+
+	//! Take a snapshot, from any thread
+	WorkerStatsSnapshot Snapshot(Clock::time_point now) const noexcept {
+		Totals const totals = getTotals(now);
+		int64_t const alive = totals.alive - m_base.alive.load(std::memory_order_relaxed);
+		int64_t const idle = totals.idle - m_base.idle.load(std::memory_order_relaxed);
+
+		WorkerStatsSnapshot snapshot;
+		snapshot.tasks = totals.tasks - m_base.tasks.load(std::memory_order_relaxed);
+		snapshot.idle = std::chrono::nanoseconds(idle > 0 ? idle : 0);
+		snapshot.busy = std::chrono::nanoseconds(alive > idle ? alive - idle : 0);
+		return snapshot;
+	}
+
+	//! Forget the statistics, from any thread
+	//!
+	//! \note Only the worker writes the counters, a reset takes their current values as the baseline
+	//!       later snapshots subtract.
+	void Reset(Clock::time_point now) noexcept {
+		Totals const totals = getTotals(now);
+		m_base.tasks.store(totals.tasks, std::memory_order_relaxed);
+		m_base.spawned.store(m_spawned.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		m_base.alive.store(totals.alive, std::memory_order_relaxed);
+		m_base.idle.store(totals.idle, std::memory_order_relaxed);
+	}
+
+private:
+	//! Counters since construction, times up to now
+	struct Totals {
+		uint64_t tasks;     //!< Number of run tasks
+		int64_t alive;      //!< Lifetime of all workers [ns]
+		int64_t idle;       //!< Idle time of all workers [ns]
+	};
+
+	//! Counters taken by the last reset
+	struct Baseline {
+		std::atomic<uint64_t> tasks{0U};    //!< Number of run tasks
+		std::atomic<uint64_t> spawned{0U};  //!< Number of tasks pushed to the own deque
+		std::atomic<int64_t> alive{0};      //!< Lifetime of all workers [ns]
+		std::atomic<int64_t> idle{0};       //!< Idle time of all workers [ns]
+	};
+
+	Totals getTotals(Clock::time_point now) const noexcept {
+		int64_t const started = m_started.load(std::memory_order_relaxed);
+		int64_t const idleSince = m_idleSince.load(std::memory_order_relaxed);
+		Totals totals;
+		totals.tasks = m_tasks.load(std::memory_order_relaxed);
+		totals.alive = m_alive.load(std::memory_order_relaxed) + (started ? ticks(now) - started : 0);
+		totals.idle = m_idle.load(std::memory_order_relaxed) + (idleSince ? ticks(now) - idleSince : 0);
+		return totals;
+	}
+
+	//! Nanoseconds of a time point, never 0 which marks unset times
+	static int64_t ticks(Clock::time_point time) noexcept {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count() | 1;
+	}
+
+	alignas(kCacheLineSize) std::atomic<uint64_t> m_tasks{0U};  //!< Number of run tasks
+	std::atomic<uint64_t> m_spawned{0U};    //!< Number of tasks pushed to the own deque
+	std::atomic<int64_t> m_alive{0};        //!< Lifetime of stopped workers [ns]
+	std::atomic<int64_t> m_idle{0};         //!< Finished idle periods [ns]
+	std::atomic<int64_t> m_started{0};      //!< Start of the running worker, 0 if none
+	std::atomic<int64_t> m_idleSince{0};    //!< Start of the current idle period, 0 if busy
+	bool m_isIdle = false;                  //!< Worker waits, only touched by the worker
+	Baseline m_base;                        //!< Written by Reset() only
+};
+
+//! Statistics of a thread pool
+//!
+//! \note
+//! In MetricsMode::kSampled the thread pushing a task decides whether it is timed, by a counter of
+//! its own, so an untimed task costs two counter increments and no clock read.
+class BASIC_SERVICES_NO_EXPORT PoolStats : public noncopyable {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	//! Set the mode and the workers slots, before the pool starts
+	//!
+	//! \param mode - What is measured
+	//! \param sampleInterval - Every sampleInterval-th task is timed in kSampled, rounded up to a power of two
+	//! \param slots - Number of worker slots
+	void Configure(MetricsMode mode, std::size_t sampleInterval, std::size_t slots) {
+		m_mode = mode;
+		m_sampleMask = roundUpPowerOfTwo(sampleInterval ? sampleInterval : 1U) - 1U;
+		m_workers.clear();
+		if (MetricsMode::kOff != mode) {
+			for (std::size_t slot = 0; slot < slots; ++slot) {
+				m_workers.emplace_back(new WorkerStats());
+			}
+		}
+		Reset();
+	}
+
+	//! Query whether anything is measured
+	bool isEnabled() const noexcept {
+		return MetricsMode::kOff != m_mode;
+	}
+
+	//! Query whether the task pushed next by the calling thread is timed
+	bool isTimed() const noexcept {
+		static thread_local std::size_t s_pushed = 0U;
+		return MetricsMode::kFull == m_mode || (MetricsMode::kSampled == m_mode && 0U == (++s_pushed & m_sampleMask));
+	}
+
+	//! Statistics of a worker slot, only while enabled
+	WorkerStats &getWorker(std::size_t slot) noexcept {
+		return *m_workers[slot];
+	}
+
+	//! A task was queued into the shared queue, leaving it with depth tasks
+	void onSubmit(std::size_t depth) noexcept {
+		m_submitted.fetch_add(1U, std::memory_order_relaxed);
+		if (depth > m_maxDepth.load(std::memory_order_relaxed)) {
+			m_maxDepth.store(depth, std::memory_order_relaxed);
+		}
+	}
+
+	//! A timed task ran
+	void onTimed(std::chrono::nanoseconds wait, std::chrono::nanoseconds run) noexcept {
+		m_queueWait.Record(uint64_t(wait.count()));
+		m_runTime.Record(uint64_t(run.count()));
+	}
+
+	//! Take a snapshot
+	//!
+	//! \param depth - Current number of queued tasks
+	PoolStatsSnapshot Snapshot(std::size_t depth) const {
+		auto const now = Clock::now();
+		PoolStatsSnapshot snapshot;
+		snapshot.submitted = m_submitted.load(std::memory_order_relaxed);
+		snapshot.queueDepth = depth;
+		snapshot.maxQueueDepth = m_maxDepth.load(std::memory_order_relaxed);
+		snapshot.elapsed = now - m_reset.load(std::memory_order_relaxed);
+		snapshot.queueWait = m_queueWait.Snapshot();
+		snapshot.runTime = m_runTime.Snapshot();
+		for (auto const &worker : m_workers) {
+			snapshot.workers.push_back(worker->Snapshot(now));
+			snapshot.completed += snapshot.workers.back().tasks;
+			snapshot.submitted += worker->getSpawned();
+		}
+		if (snapshot.elapsed.count() > 0) {
+			snapshot.tasksPerSecond = double(snapshot.completed) * 1e9 / double(snapshot.elapsed.count());
+		}
+		return snapshot;
+	}
+
+	//! Forget all statistics
+	void Reset() noexcept {
+		auto const now = Clock::now();
+		m_submitted.store(0U, std::memory_order_relaxed);
+		m_maxDepth.store(0U, std::memory_order_relaxed);
+		m_queueWait.Reset();
+		m_runTime.Reset();
+		for (auto &worker : m_workers) {
+			worker->Reset(now);
+		}
+		m_reset.store(now, std::memory_order_relaxed);
+	}
+
+private:
+	MetricsMode m_mode = MetricsMode::kOff;                 //!< What is measured
+	std::size_t m_sampleMask = 0U;                          //!< Timed tasks in kSampled, as mask of a power of two
+	std::atomic<uint64_t> m_submitted{0U};                  //!< Number of tasks queued into the shared queue
+	std::atomic<std::size_t> m_maxDepth{0U};                //!< Highest depth of the shared queue
+	std::atomic<Clock::time_point> m_reset{};               //!< Time of start or reset
+	LatencyHistogram m_queueWait;                           //!< Queue wait of timed tasks [ns]
+	LatencyHistogram m_runTime;                             //!< Run time of timed tasks [ns]
+	std::vector<std::unique_ptr<WorkerStats> > m_workers;   //!< Statistics by worker slot
+};
+
+} // namespace detail
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_POOL_STATS_H
@@ -0,0 +1,235 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_PRIORITY_QUEUE_H
+#define BASIC_SERVICES_PRIORITY_QUEUE_H
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class PriorityQueue
+//!
+//! \brief
+//! A thread safe queue with a fixed number of FIFO priority lanes
+//!
+//! \note
+//! Pop always serves the highest non-empty lane; the lane with the highest index has the
+//! highest priority. A bitmap of non-empty lanes turns the lane lookup into a single
+//! leading-zero count. Besides the total capacity each lane may be bounded on its own,
+//! so a flood in one lane cannot take all the space from the others.
+//!
+//! \tparam T - Value type
+//! \tparam Lanes - Number of priority lanes (1..64)
+template<typename T, std::size_t Lanes>
+class BASIC_SERVICES_EXPORT PriorityQueue : public noncopyable {
+	static_assert(Lanes >= 1U && Lanes <= 64U, "number of lanes must be within 1..64");
+
+public:
+	using value_type = T;
+	using reference = T &;
+	using point_type = T *;
+	using const_reference = const T &;
+	using lane_type = std::size_t;
+
+	static constexpr lane_type kLowest = 0U;             //!< Lane with the lowest priority
+	static constexpr lane_type kHighest = Lanes - 1U;    //!< Lane with the highest priority
+
+public:
+	//! Constructor
+	//!
+	//! \param cap - Capacity (Maximum size) of the whole queue (0 means unlimited)
+	//! \param lane_cap - Capacity of every single lane (0 means unlimited)
+	explicit PriorityQueue(std::size_t cap = 0, std::size_t lane_cap = 0)
+			: m_capacity(cap) {
+		m_laneCapacity.fill(lane_cap);
+	}
+
+	//! Destructor
+	~PriorityQueue() = default;
+
+	//! Query whether queue is empty
+	bool isEmpty() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return 0U == m_ready;
+	}
+
+	//! Query whether queue is full
+	bool isFull() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_capacity > 0 && m_size >= m_capacity;
+	}
+
+	//! Query the current amount of values in the queue
+	std::size_t Size() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_size;
+	}
+
+	//! Query the current amount of values in one lane
+	std::size_t Size(lane_type lane) const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_lanes[clamp(lane)].size();
+	}
+
+	//! Clear the queue
+	void Clear() {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		for (auto &queue : m_lanes) {
+			queue = {};
+		}
+		m_ready = 0U;
+		m_size = 0U;
+		m_condPop.notify_all();
+	}
+
+	//! Set the capacity of the whole queue
+	void setCapacity(std::size_t cap) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_capacity = cap;
+		m_condPop.notify_all();
+	}
+
+	//! Query the capacity of the whole queue
+	std::size_t getCapacity() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_capacity;
+	}
+
+	//! Set the capacity of one lane
+	//!
+	//! \param lane - Lane to configure
+	//! \param cap - Capacity of the lane (0 means unlimited)
+	void setCapacity(lane_type lane, std::size_t cap) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_laneCapacity[clamp(lane)] = cap;
+		m_condPop.notify_all();
+	}
+
+	//! Query the capacity of one lane
+	std::size_t getCapacity(lane_type lane) const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_laneCapacity[clamp(lane)];
+	}
+
+	//! Push value into a lane of the queue
+	//!
+	//! \note
+	//! If the capacity of the queue or of the lane is reached the caller blocks until a value is popped.
+	//! \param value - Value to be pushed
+	//! \param lane - Priority lane, out of range lanes are taken as kLowest
+	void Push(const_reference value, lane_type lane = kLowest) {
+		push(value, clamp(lane));
+	}
+
+	//! Move value into a lane of the queue
+	//!
+	//! \note
+	//! If the capacity of the queue or of the lane is reached the caller blocks until a value is popped.
+	//! \param value - Value to be pushed
+	//! \param lane - Priority lane, out of range lanes are taken as kLowest
+	void Push(value_type &&value, lane_type lane = kLowest) {
+		push(std::move(value), clamp(lane));
+	}
+
+	//! Pop the value with the highest priority out of the queue
+	//!
+	//! \note
+	//! If the queue is empty the caller blocks until a value is pushed into the queue.
+	//! \return Value be popped
+	value_type Pop() {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		while (0U == m_ready) {
+			m_condPush.wait(lk);
+		}
+
+		return pop();
+	}
+
+	//! Try to pop the value with the highest priority out of the queue
+	//!
+	//! \param value - Receives the popped value
+	//! \retval true - Value popped
+	//! \retval false - Queue is empty
+	bool TryPop(reference value) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		if (0U == m_ready) {
+			return false;
+		}
+
+		value = pop();
+		return true;
+	}
+
+private:
+	//! Map an out of range lane to the lowest one, so a bad lane never jumps ahead of valid values
+	static lane_type clamp(lane_type lane) {
+		assert(lane < Lanes);
+		return (lane < Lanes) ? lane : kLowest;
+	}
+
+	bool isFull(lane_type lane) const {
+		return (m_capacity > 0 && m_size >= m_capacity)
+		       || (m_laneCapacity[lane] > 0 && m_lanes[lane].size() >= m_laneCapacity[lane]);
+	}
+
+	template<typename U>
+	void push(U &&value, lane_type lane) {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		while (isFull(lane)) {
+			++m_pushWaiters;
+			m_condPop.wait(lk);
+			--m_pushWaiters;
+		}
+
+		m_lanes[lane].push(std::forward<U>(value));
+		m_ready |= uint64_t(1U) << lane;
+		++m_size;
+		m_condPush.notify_one();
+	}
+
+	//! Take the front value of the highest ready lane (lock must be held, queue must not be empty)
+	value_type pop() {
+		auto const lane = lane_type(63 - countLeadingZeros(m_ready));
+		std::queue<value_type> &queue = m_lanes[lane];
+
+		value_type value = std::move(queue.front());
+		queue.pop();
+		if (queue.empty()) {
+			m_ready &= ~(uint64_t(1U) << lane);
+		}
+		--m_size;
+
+		// producers may wait on different lanes, wake all of them
+		if (0U != m_pushWaiters) {
+			m_condPop.notify_all();
+		}
+
+		return value;
+	}
+
+private:
+	std::size_t m_capacity;                                 //!< Capacity of the whole queue
+	std::array<std::size_t, Lanes> m_laneCapacity;          //!< Capacity of every lane
+	std::array<std::queue<value_type>, Lanes> m_lanes;      //!< FIFO per lane
+	uint64_t m_ready = 0U;                                  //!< Bitmap of non-empty lanes
+	std::size_t m_size = 0U;                                //!< Values in all lanes
+	std::size_t m_pushWaiters = 0U;                         //!< Producers blocked on a full queue or lane
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condPop;
+	std::condition_variable m_condPush;
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_PRIORITY_QUEUE_H
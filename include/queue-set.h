@@ -0,0 +1,145 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_QUEUE_SET_H
+#define BASIC_SERVICES_QUEUE_SET_H
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <optional>
+
+#include "noncopyable.h"
+#include "wait-strategy.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class QueueSet
+//!
+//! \brief
+//! Lets a consumer wait on several queues at once until any of them holds a value
+//!
+//! \note
+//! All member queues wake up one shared Parker when values are pushed, and waiters probe the
+//! lock-free Size() of the members, so waiting costs no polling and no extra lock per queue.
+//! Members are scanned round-robin, starting after the queue returned last, so a busy queue
+//! cannot starve the others. WaitAny() only tells which queue was non-empty; with several
+//! consumers on the same queue the value may be gone again, so pop it with TryPop().
+//! A queue may be member of one set at a time, and has to be added before values are pushed
+//! concurrently. Members must outlive the set, which detaches them on destruction.
+//! Works with any queue providing Size() and attachNotifier(Parker *), e.g. Queue.
+class BASIC_SERVICES_EXPORT QueueSet : public noncopyable {
+public:
+	//! Constructor
+	//!
+	//! \param strategy - How WaitAny waits while all queues are empty
+	explicit QueueSet(WaitStrategy strategy = WaitStrategy::kBlock)
+			: m_waitStrategy(strategy) {}
+
+	//! Destructor
+	~QueueSet() {
+		for (auto const &member : m_members) {
+			member.detach(member.queue);
+		}
+	}
+
+	//! Add a queue to the set
+	//!
+	//! \param queue - Queue to add
+	//! \return Index of the queue in the set, as returned by WaitAny
+	template<typename Q>
+	std::size_t Add(Q &queue) {
+		m_members.push_back(Member{
+				&queue,
+				[](void const *q) { return static_cast<Q const *>(q)->Size(); },
+				[](void *q) { static_cast<Q *>(q)->attachNotifier(nullptr); }
+		});
+		queue.attachNotifier(&m_notEmpty);
+
+		return m_members.size() - 1U;
+	}
+
+	//! Query the number of queues in the set
+	std::size_t Size() const {
+		return m_members.size();
+	}
+
+	//! Wait until any queue of the set holds a value
+	//!
+	//! \return Index of a non-empty queue
+	std::size_t WaitAny() {
+		std::size_t index = 0;
+		auto const ready = [this, &index] { return probe(index); };
+		if (!spinWait(m_waitStrategy, ready)) {
+			m_notEmpty.Park(ready);
+		}
+
+		return index;
+	}
+
+	//! Wait until any queue of the set holds a value or the timeout expires
+	//!
+	//! \param timeout - Maximum time to wait
+	//! \return Index of a non-empty queue, empty on timeout
+	template<typename Rep, typename Period>
+	std::optional<std::size_t> WaitAny(std::chrono::duration<Rep, Period> const &timeout) {
+		auto const deadline = std::chrono::steady_clock::now() + timeout;
+		std::size_t index = 0;
+		auto const ready = [this, &index] { return probe(index); };
+		auto const readyOrTimeout = [&ready, deadline] {
+			return ready() || std::chrono::steady_clock::now() >= deadline;
+		};
+
+		bool found = false;
+		if (spinWait(m_waitStrategy, readyOrTimeout)) {
+			found = ready();
+		} else {
+			found = m_notEmpty.ParkUntil(ready, deadline);
+		}
+
+		return found ? std::optional<std::size_t>(index) : std::nullopt;
+	}
+
+	//! Query which queue holds a value, without waiting
+	//!
+	//! \return Index of a non-empty queue, empty if all queues are empty
+	std::optional<std::size_t> TryAny() {
+		std::size_t index = 0;
+		return probe(index) ? std::optional<std::size_t>(index) : std::nullopt;
+	}
+
+private:
+	//! Type erased member queue
+	struct Member {
+		void *queue;
+		std::size_t (*size)(void const *);
+		void (*detach)(void *);
+	};
+
+	//! Find a non-empty queue, starting after the last one found
+	bool probe(std::size_t &index) {
+		std::size_t const count = m_members.size();
+		std::size_t const last = m_last.load(std::memory_order_relaxed);
+		for (std::size_t i = 1; i <= count; ++i) {
+			std::size_t const candidate = (last + i) % count;
+			if (0U != m_members[candidate].size(m_members[candidate].queue)) {
+				index = candidate;
+				m_last.store(candidate, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	WaitStrategy const m_waitStrategy;      //!< How WaitAny waits
+	std::vector<Member> m_members;          //!< Member queues
+	std::atomic<std::size_t> m_last{0U};    //!< Index returned last, start of the next scan
+	Parker m_notEmpty;                      //!< Woken up by every push into a member
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_QUEUE_SET_H
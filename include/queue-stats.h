@@ -0,0 +1,114 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_QUEUE_STATS_H
+#define BASIC_SERVICES_QUEUE_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "histogram.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Snapshot of the statistics of a queue
+struct QueueStatsSnapshot {
+	uint64_t enqueued = 0U;                         //!< Number of pushed values
+	uint64_t dequeued = 0U;                         //!< Number of popped values
+	uint64_t highWaterMark = 0U;                    //!< Highest observed depth
+	uint64_t contentions = 0U;                      //!< Lock acquisitions which found the mutex taken
+	std::chrono::nanoseconds producerBlocked{0};    //!< Total time producers waited on a full queue
+	std::chrono::nanoseconds consumerBlocked{0};    //!< Total time consumers waited on an empty queue
+	Histogram producerWait;                         //!< Wait times of producers on a full queue [ns]
+	Histogram consumerWait;                         //!< Wait times of consumers on an empty queue [ns]
+};
+
+//! Statistics policy of a queue which compiles all instrumentation out (default)
+struct NoQueueStats {
+	static constexpr bool kEnabled = false;
+
+	void onEnqueue(std::size_t, std::size_t) noexcept {}
+	void onDequeue(std::size_t) noexcept {}
+	void onContention() noexcept {}
+	void onProducerBlocked(std::chrono::nanoseconds) noexcept {}
+	void onConsumerBlocked(std::chrono::nanoseconds) noexcept {}
+	QueueStatsSnapshot Snapshot() const { return {}; }
+	void Reset() noexcept {}
+};
+
+//! Statistics policy of a queue which records counters, depth and blocking times
+//!
+//! \note
+//! Counters are relaxed atomics, so snapshots may be taken from any thread at any time.
+class BASIC_SERVICES_EXPORT QueueStats : public noncopyable {
+public:
+	static constexpr bool kEnabled = true;
+
+	//! Values were pushed, leaving the queue with depth values
+	void onEnqueue(std::size_t count, std::size_t depth) noexcept {
+		m_enqueued.fetch_add(count, std::memory_order_relaxed);
+		if (depth > m_highWaterMark.load(std::memory_order_relaxed)) {
+			m_highWaterMark.store(depth, std::memory_order_relaxed);
+		}
+	}
+
+	//! Values were popped
+	void onDequeue(std::size_t count) noexcept {
+		m_dequeued.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	//! The mutex was found taken
+	void onContention() noexcept {
+		m_contentions.fetch_add(1U, std::memory_order_relaxed);
+	}
+
+	//! A producer waited on a full queue
+	void onProducerBlocked(std::chrono::nanoseconds duration) noexcept {
+		m_producerWait.Record(uint64_t(duration.count()));
+	}
+
+	//! A consumer waited on an empty queue
+	void onConsumerBlocked(std::chrono::nanoseconds duration) noexcept {
+		m_consumerWait.Record(uint64_t(duration.count()));
+	}
+
+	//! Take a snapshot of the statistics
+	QueueStatsSnapshot Snapshot() const {
+		QueueStatsSnapshot snapshot;
+		snapshot.enqueued = m_enqueued.load(std::memory_order_relaxed);
+		snapshot.dequeued = m_dequeued.load(std::memory_order_relaxed);
+		snapshot.highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+		snapshot.contentions = m_contentions.load(std::memory_order_relaxed);
+		snapshot.producerWait = m_producerWait.Snapshot();
+		snapshot.consumerWait = m_consumerWait.Snapshot();
+		snapshot.producerBlocked = std::chrono::nanoseconds(snapshot.producerWait.Sum());
+		snapshot.consumerBlocked = std::chrono::nanoseconds(snapshot.consumerWait.Sum());
+		return snapshot;
+	}
+
+	//! Reset all statistics
+	void Reset() noexcept {
+		m_enqueued.store(0U, std::memory_order_relaxed);
+		m_dequeued.store(0U, std::memory_order_relaxed);
+		m_highWaterMark.store(0U, std::memory_order_relaxed);
+		m_contentions.store(0U, std::memory_order_relaxed);
+		m_producerWait.Reset();
+		m_consumerWait.Reset();
+	}
+
+private:
+	std::atomic<uint64_t> m_enqueued{0U};
+	std::atomic<uint64_t> m_dequeued{0U};
+	std::atomic<uint64_t> m_highWaterMark{0U};
+	std::atomic<uint64_t> m_contentions{0U};
+	LatencyHistogram m_producerWait;
+	LatencyHistogram m_consumerWait;
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_QUEUE_STATS_H
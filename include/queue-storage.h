@@ -0,0 +1,231 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_QUEUE_STORAGE_H
+#define BASIC_SERVICES_QUEUE_STORAGE_H
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+namespace detail {
+
+//! Template Class QueueStorage
+//!
+//! \brief
+//! FIFO storage of a queue which does not allocate in steady state
+//!
+//! \note
+//! With a capacity all values live in one contiguous ring of that size, allocated once.
+//! Without a capacity values live in a chain of fixed size segments; segments which run
+//! empty are kept on a freelist and reused for later growth instead of being returned
+//! to the heap, so a queue only allocates while it grows beyond its previous peak.
+//! The class is not thread safe, the owning queue serializes all access.
+template<typename T>
+class BASIC_SERVICES_NO_EXPORT QueueStorage : public noncopyable {
+public:
+	using value_type = T;
+	using reference = T &;
+	using point_type = T *;
+
+	//! Number of values per segment in unbounded mode
+	static constexpr std::size_t kSegmentSize = std::max<std::size_t>(16U, 4096U / sizeof(T));
+
+public:
+	//! Constructor
+	//!
+	//! \param capacity - Size of the contiguous ring (0 selects the unbounded segment chain)
+	explicit QueueStorage(std::size_t capacity = 0) {
+		if (capacity > 0) {
+			m_ring = std::make_unique<Storage[]>(capacity);
+			m_ringSize = capacity;
+		}
+	}
+
+	//! Move constructor
+	QueueStorage(QueueStorage &&rhs) noexcept
+			: m_ring(std::move(rhs.m_ring)), m_ringSize(rhs.m_ringSize), m_first(rhs.m_first), m_last(rhs.m_last),
+			  m_free(rhs.m_free), m_head(rhs.m_head), m_tail(rhs.m_tail), m_size(rhs.m_size) {
+		rhs.m_ringSize = 0;
+		rhs.m_first = rhs.m_last = rhs.m_free = nullptr;
+		rhs.m_head = rhs.m_tail = rhs.m_size = 0;
+	}
+
+	//! Destructor
+	~QueueStorage() {
+		clear();
+		release(m_first);
+		release(m_free);
+	}
+
+	//! Query whether storage is empty
+	bool empty() const noexcept {
+		return 0 == m_size;
+	}
+
+	//! Query the number of stored values
+	std::size_t size() const noexcept {
+		return m_size;
+	}
+
+	//! Access the oldest value
+	reference front() noexcept {
+		return *head();
+	}
+
+	//! Append a value
+	//!
+	//! \note In ring mode the caller must make sure the ring is not full
+	template<typename U>
+	void push(U &&value) {
+		if (m_ring) {
+			std::size_t index = m_head + m_size;
+			if (index >= m_ringSize) {
+				index -= m_ringSize;
+			}
+			::new(static_cast<void *>(&m_ring[index])) value_type(std::forward<U>(value));
+		} else {
+			if (nullptr == m_last || kSegmentSize == m_tail) {
+				append();
+			}
+			::new(static_cast<void *>(&m_last->m_slots[m_tail])) value_type(std::forward<U>(value));
+			++m_tail;
+		}
+		++m_size;
+	}
+
+	//! Remove the oldest value
+	void pop() noexcept {
+		head()->~value_type();
+		--m_size;
+		++m_head;
+
+		if (m_ring) {
+			if (m_head == m_ringSize) {
+				m_head = 0;
+			}
+		} else if (0 == m_size) {
+			// rewind, so a breathing queue keeps using its first segment
+			m_head = m_tail = 0;
+			recycle(m_first->m_next);
+			m_first->m_next = nullptr;
+			m_last = m_first;
+		} else if (kSegmentSize == m_head) {
+			Segment *const segment = m_first;
+			m_first = segment->m_next;
+			segment->m_next = nullptr;
+			recycle(segment);
+			m_head = 0;
+		}
+	}
+
+	//! Remove all values, keeping the allocated storage
+	void clear() noexcept {
+		while (m_size) {
+			pop();
+		}
+	}
+
+	//! Change the layout for a new capacity
+	//!
+	//! \brief
+	//! Switches to a ring of the given capacity (or to the segment chain for 0), moving over all
+	//! stored values. A ring never gets smaller than the number of stored values.
+	//! \param capacity - New capacity
+	void reserve(std::size_t capacity) {
+		capacity = (capacity > 0) ? std::max(capacity, m_size) : 0;
+		if ((capacity > 0 && capacity == m_ringSize) || (0 == capacity && !m_ring)) {
+			return;
+		}
+
+		QueueStorage storage(capacity);
+		while (m_size) {
+			storage.push(std::move(front()));
+			pop();
+		}
+		std::swap(m_ring, storage.m_ring);
+		std::swap(m_ringSize, storage.m_ringSize);
+		std::swap(m_first, storage.m_first);
+		std::swap(m_last, storage.m_last);
+		std::swap(m_free, storage.m_free);
+		std::swap(m_head, storage.m_head);
+		std::swap(m_tail, storage.m_tail);
+		std::swap(m_size, storage.m_size);
+	}
+
+private:
+	using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	//! Segment of the unbounded chain
+	struct Segment {
+		Storage m_slots[kSegmentSize];  //!< Value storage
+		Segment *m_next = nullptr;      //!< Next segment in the chain or on the freelist
+	};
+
+	//! Slot of the oldest value
+	point_type head() noexcept {
+		Storage *const slots = m_ring ? m_ring.get() : m_first->m_slots;
+		return reinterpret_cast<point_type>(&slots[m_head]);
+	}
+
+	//! Link a segment from the freelist (or the heap) to the end of the chain
+	void append() {
+		Segment *segment = m_free;
+		if (nullptr != segment) {
+			m_free = segment->m_next;
+			segment->m_next = nullptr;
+		} else {
+			segment = new Segment;
+		}
+
+		if (nullptr == m_last) {
+			m_first = segment;
+		} else {
+			m_last->m_next = segment;
+		}
+		m_last = segment;
+		m_tail = 0;
+	}
+
+	//! Put a chain of segments on the freelist
+	void recycle(Segment *segment) noexcept {
+		while (nullptr != segment) {
+			Segment *const next = segment->m_next;
+			segment->m_next = m_free;
+			m_free = segment;
+			segment = next;
+		}
+	}
+
+	//! Return a chain of segments to the heap
+	static void release(Segment *segment) noexcept {
+		while (nullptr != segment) {
+			Segment *const next = segment->m_next;
+			delete segment;
+			segment = next;
+		}
+	}
+
+private:
+	std::unique_ptr<Storage[]> m_ring;  //!< Contiguous ring (bounded mode)
+	std::size_t m_ringSize = 0;         //!< Size of the ring
+	Segment *m_first = nullptr;         //!< Oldest segment of the chain (unbounded mode)
+	Segment *m_last = nullptr;          //!< Newest segment of the chain (unbounded mode)
+	Segment *m_free = nullptr;          //!< Recycled segments (unbounded mode)
+	std::size_t m_head = 0;             //!< Index of the oldest value (in the ring or in m_first)
+	std::size_t m_tail = 0;             //!< Index past the newest value in m_last (unbounded mode)
+	std::size_t m_size = 0;             //!< Number of stored values
+};
+
+} // namespace detail
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_QUEUE_STORAGE_H
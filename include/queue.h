@@ -5,12 +5,19 @@
 #ifndef BASIC_SERVICES_QUEUE_H
 #define BASIC_SERVICES_QUEUE_H
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
-#include <queue>
 #include <mutex>
+#include <vector>
+#include <iterator>
 #include <condition_variable>
 
+#include "event-fd.h"
 #include "noncopyable.h"
+#include "queue-stats.h"
+#include "queue-storage.h"
+#include "wait-strategy.h"
 #include "basic-services_export.h"
 
 namespace basic {
@@ -19,7 +26,16 @@ namespace basic {
 //!
 //! \brief
 //! A thread safe queue implementation
-template<typename T>
+//!
+//! \note
+//! Consumers waiting on an empty queue follow the wait strategy given at construction,
+//! producers waiting on a full queue always block.
+//! A bounded queue keeps its values in one ring allocated up front, an unbounded queue
+//! recycles its storage segments, so Push and Pop do not allocate in steady state.
+//!
+//! \tparam T - Value type
+//! \tparam Stats - Statistics policy, QueueStats to record statistics, NoQueueStats (default) to compile them out
+template<typename T, typename Stats = NoQueueStats>
 class BASIC_SERVICES_EXPORT Queue : public noncopyable {
 public:
 	using value_type = T;
@@ -31,13 +47,15 @@ public:
 	//! Constructor
 	//!
 	//! \param cap - Capacity (Maximum size) of the queue (0 means unlimited)
-	explicit Queue(std::size_t cap = 0)
-			: m_capacity(cap), m_mutex{}, m_condPop{}, m_condPush{} {}
+	//! \param strategy - How consumers wait on an empty queue
+	explicit Queue(std::size_t cap = 0, WaitStrategy strategy = WaitStrategy::kBlock)
+			: m_capacity(cap), m_waitStrategy(strategy), m_queue(cap), m_mutex{}, m_condPop{}, m_condPush{} {}
 
 	//! Move Constructor
 	Queue(Queue &&q) noexcept
-			: m_capacity(q.m_capacity), m_mutex(std::move(q.m_mutex)), m_condPop(std::move(q.m_condPop)),
-			  m_condPush(std::move(q.m_condPush)), m_queue(std::move(q.m_queue)) {
+			: m_capacity(q.m_capacity), m_waitStrategy(q.m_waitStrategy), m_mutex(std::move(q.m_mutex)),
+			  m_condPop(std::move(q.m_condPop)), m_condPush(std::move(q.m_condPush)), m_queue(std::move(q.m_queue)),
+			  m_size(q.m_size.load()), m_notifier(q.m_notifier.load()), m_eventFd(std::move(q.m_eventFd)) {
 
 	}
 
@@ -64,15 +82,18 @@ public:
 
 	//! Query size of the queue
 	std::size_t Size() const {
-		std::lock_guard<std::mutex> lk(m_mutex);
-		std::size_t size = m_queue.size();
-		return size;
+		return m_size.load(std::memory_order_relaxed);
 	}
 
 	//! Clear the queue
 	void Clear() {
 		std::lock_guard<std::mutex> lk(m_mutex);
 		m_queue.clear();
+		m_size.store(0, std::memory_order_relaxed);
+		if (m_eventFd) {
+			m_eventFd->Drain();
+		}
+		m_condPop.notify_all();
 	}
 
 	//! Set the capacity of the queue
@@ -80,7 +101,9 @@ public:
 	//! \param cap - Capacity to set
 	void setCapacity(std::size_t cap) {
 		std::lock_guard<std::mutex> lk(m_mutex);
+		m_queue.reserve(cap);
 		m_capacity = cap;
+		m_condPop.notify_all();
 	}
 
 	//! Query the capacity of the queue
@@ -96,9 +119,61 @@ public:
 	//! \return Number of values
 	std::size_t Size()
 	{
+		return m_size.load(std::memory_order_relaxed);
+	}
+
+	//! Attach a parker which is woken up whenever values are pushed
+	//!
+	//! \note
+	//! Used by QueueSet to wait on several queues at once. A queue has at most one notifier,
+	//! pass nullptr to detach it.
+	//! \param notifier - Parker to wake up
+	void attachNotifier(Parker *notifier) {
+		m_notifier.store(notifier, std::memory_order_release);
+	}
+
+	//! Let the queue own an event descriptor for poll/epoll loops
+	//!
+	//! \note
+	//! The descriptor is readable exactly while the queue holds values: it is signalled on the
+	//! empty to non-empty transition and reset by the pop which empties the queue, so it only costs
+	//! a system call per transition. Drain the queue with TryPopBulk once the descriptor is readable.
+	//! Not available on Windows.
+	//! \return File descriptor to wait on, -1 if not available
+	int enableEventFd() {
 		std::lock_guard<std::mutex> lk(m_mutex);
-		std::size_t size = m_queue.size();
-		return size;
+		if (!m_eventFd) {
+			auto eventFd = std::make_unique<EventFd>();
+			if (!*eventFd) {
+				return -1;
+			}
+			if (!m_queue.empty()) {
+				eventFd->Signal();
+			}
+			m_eventFd = std::move(eventFd);
+		}
+		return m_eventFd->getFd();
+	}
+
+	//! Query the event descriptor
+	//!
+	//! \return File descriptor to wait on, -1 if enableEventFd was not called
+	int getEventFd() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_eventFd ? m_eventFd->getFd() : -1;
+	}
+
+	//! Take a snapshot of the queue statistics
+	//!
+	//! \note Only recorded when the queue is instantiated with QueueStats
+	//! \return Statistics snapshot
+	QueueStatsSnapshot getStats() const {
+		return m_stats.Snapshot();
+	}
+
+	//! Reset the queue statistics
+	void resetStats() {
+		m_stats.Reset();
 	}
 
 	//! Push value into the queue
@@ -110,13 +185,16 @@ public:
 	//! If the capacity is reached the caller blocks until a value is popped from the queue.
 	//! \param value - Value to be pushed
 	void Push(const_reference value) {
-		std::unique_lock<std::mutex> lk(m_mutex);
-		while (m_capacity > 0 && m_queue.size() >= m_capacity) {
-			m_condPop.wait(lk);
-		}
+		std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
+		lock(lk);
+		waitNotFull(lk);
 
 		m_queue.push(value);
+		publishPush(1);
+		m_stats.onEnqueue(1, m_queue.size());
 		m_condPush.notify_one();
+		lk.unlock();
+		signal();
 	}
 
 	//! Move value into the queue
@@ -128,13 +206,16 @@ public:
 	//! If the capacity is reached the caller blocks until a value is popped from the queue.
 	//! \param value - Value to be pushed
 	void Push(value_type &&value) {
-		std::unique_lock<std::mutex> lk(m_mutex);
-		while (m_capacity > 0 && m_queue.size() >= m_capacity) {
-			m_condPop.wait(lk);
-		}
+		std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
+		lock(lk);
+		waitNotFull(lk);
 
 		m_queue.push(std::move(value));
+		publishPush(1);
+		m_stats.onEnqueue(1, m_queue.size());
 		m_condPush.notify_one();
+		lk.unlock();
+		signal();
 	}
 
 	//! Pop value out of the queue
@@ -146,24 +227,285 @@ public:
 	//! If the queue is empty the caller blocks until a value is pushed into the queue.
 	//! \return Value be popped
 	value_type Pop() {
-		std::unique_lock<std::mutex> lk(m_mutex);
-		while (m_queue.empty()) {
-			m_condPush.wait(lk);
-		}
+		std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
+		waitNotEmpty(lk);
 
 		T value = std::move(m_queue.front());
 		m_queue.pop();
+		publishPop();
+		m_stats.onDequeue(1);
 		m_condPop.notify_one();
 
 		return value;
 	}
 
+	//! Try to pop value out of the queue
+	//!
+	//! \param value - Receives the popped value
+	//! \retval true - Value popped
+	//! \retval false - Queue is empty
+	bool TryPop(reference value) {
+		if (0 == m_size.load(std::memory_order_relaxed)) {
+			return false;
+		}
+
+		std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
+		lock(lk);
+		if (m_queue.empty()) {
+			return false;
+		}
+		popSome(&value, 1);
+
+		return true;
+	}
+
+	//! Push a range of values into the queue
+	//!
+	//!\brief
+	//! Push all values of [first, last) holding the lock once per batch and waking consumers once per batch
+	//!
+	//! \note
+	//! If the capacity is reached the caller blocks only for the part of the range that does not fit.
+	//! \param first - Begin of the range to be pushed
+	//! \param last - End of the range to be pushed
+	template<typename InputIt>
+	void PushBulk(InputIt first, InputIt last) {
+		std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
+		lock(lk);
+		while (first != last) {
+			waitNotFull(lk);
+
+			std::size_t pushed = 0;
+			for (; first != last && (0 == m_capacity || m_queue.size() < m_capacity); ++first, ++pushed) {
+				m_queue.push(*first);
+			}
+			publishPush(pushed);
+			m_stats.onEnqueue(pushed, m_queue.size());
+			notify(m_condPush, pushed);
+			// per batch, as a set consumer has to make room for the rest of the range
+			signal();
+		}
+	}
+
+	//! Pop several values out of the queue
+	//!
+	//!\brief
+	//! Pop up to max_n values holding the lock once and waking producers once
+	//!
+	//! \note
+	//! If the queue is empty the caller blocks until a value is pushed into the queue.
+	//! \param out - Output iterator receiving the popped values
+	//! \param max_n - Maximum number of values to pop
+	//! \return Number of values popped
+	template<typename OutputIt>
+	std::size_t PopBulk(OutputIt out, std::size_t max_n) {
+		std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
+		waitNotEmpty(lk);
+
+		return popSome(out, max_n);
+	}
+
+	//! Try to pop several values out of the queue
+	//!
+	//!\brief
+	//! Pop up to max_n values holding the lock once and waking producers once, without waiting
+	//!
+	//! \param out - Output iterator receiving the popped values
+	//! \param max_n - Maximum number of values to pop
+	//! \return Number of values popped, 0 if the queue is empty
+	template<typename OutputIt>
+	std::size_t TryPopBulk(OutputIt out, std::size_t max_n) {
+		if (0 == m_size.load(std::memory_order_relaxed)) {
+			return 0;
+		}
+
+		std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
+		lock(lk);
+		return popSome(out, max_n);
+	}
+
+	//! Pop several values out of the queue with timeout
+	//!
+	//!\brief
+	//! Pop up to max_n values holding the lock once and waking producers once
+	//!
+	//! \note
+	//! If the queue is empty the caller blocks until a value is pushed or the timeout expires.
+	//! \param max_n - Maximum number of values to pop
+	//! \param timeout - Maximum time to wait for the first value
+	//! \return Values popped, empty on timeout
+	template<typename Rep, typename Period>
+	std::vector<value_type> PopBulk(std::size_t max_n, std::chrono::duration<Rep, Period> const &timeout) {
+		std::vector<value_type> values;
+		std::unique_lock<std::mutex> lk(m_mutex, std::defer_lock);
+		if (waitNotEmptyUntil(lk, std::chrono::steady_clock::now() + timeout)) {
+			values.reserve(std::min(max_n, m_queue.size()));
+			popSome(std::back_inserter(values), max_n);
+		}
+
+		return values;
+	}
+
+private:
+	//! Wake up the attached notifier, if any
+	//!
+	//! \note Waiters on the notifier only read m_size, so this may be called with or without the lock held.
+	void signal() {
+		Parker *const notifier = m_notifier.load(std::memory_order_acquire);
+		if (nullptr != notifier) {
+			notifier->UnparkAll();
+		}
+	}
+
+	//! Publish the size after count values were pushed (lock must be held)
+	void publishPush(std::size_t count) {
+		m_size.store(m_queue.size(), std::memory_order_relaxed);
+		if (m_eventFd && count > 0 && m_queue.size() == count) {
+			m_eventFd->Signal();
+		}
+	}
+
+	//! Publish the size after values were popped (lock must be held)
+	void publishPop() {
+		m_size.store(m_queue.size(), std::memory_order_relaxed);
+		if (m_eventFd && m_queue.empty()) {
+			m_eventFd->Drain();
+		}
+	}
+
+	//! Wake up as many waiters as values were transferred, with a single call
+	static void notify(std::condition_variable &cond, std::size_t count) {
+		if (1 == count) {
+			cond.notify_one();
+		} else if (count > 1) {
+			cond.notify_all();
+		}
+	}
+
+	//! Acquire the mutex, counting contention when statistics are enabled
+	//!
+	//! \param lk - Unlocked lock of m_mutex, returned locked
+	void lock(std::unique_lock<std::mutex> &lk) {
+		if constexpr (Stats::kEnabled) {
+			if (lk.try_lock()) {
+				return;
+			}
+			m_stats.onContention();
+		}
+		lk.lock();
+	}
+
+	//! Block while the queue is full (lock must be held)
+	void waitNotFull(std::unique_lock<std::mutex> &lk) {
+		if (m_capacity > 0 && m_queue.size() >= m_capacity) {
+			std::chrono::steady_clock::time_point start;
+			if constexpr (Stats::kEnabled) {
+				start = std::chrono::steady_clock::now();
+			}
+
+			do {
+				m_condPop.wait(lk);
+			} while (m_capacity > 0 && m_queue.size() >= m_capacity);
+
+			if constexpr (Stats::kEnabled) {
+				m_stats.onProducerBlocked(std::chrono::steady_clock::now() - start);
+			}
+		}
+	}
+
+	//! Wait according to the wait strategy until the queue holds a value
+	//!
+	//! \param lk - Unlocked lock of m_mutex, returned locked
+	void waitNotEmpty(std::unique_lock<std::mutex> &lk) {
+		auto const ready = [this] { return 0 != m_size.load(std::memory_order_relaxed); };
+
+		std::chrono::steady_clock::time_point start;
+		bool blocked = false;
+		if constexpr (Stats::kEnabled) {
+			blocked = !ready();
+			if (blocked) {
+				start = std::chrono::steady_clock::now();
+			}
+		}
+
+		for (;;) {
+			if (WaitStrategy::kBlock != m_waitStrategy) {
+				spinWait(m_waitStrategy, ready);
+			}
+
+			lock(lk);
+			if (isParking(m_waitStrategy)) {
+				while (m_queue.empty()) {
+					m_condPush.wait(lk);
+				}
+				break;
+			}
+			if (!m_queue.empty()) {
+				break;
+			}
+			// another consumer was faster, spin again
+			lk.unlock();
+		}
+
+		if constexpr (Stats::kEnabled) {
+			if (blocked) {
+				m_stats.onConsumerBlocked(std::chrono::steady_clock::now() - start);
+			}
+		}
+	}
+
+	//! Wait according to the wait strategy until the queue holds a value or the deadline passed
+	//!
+	//! \param lk - Unlocked lock of m_mutex, returned locked
+	//! \param deadline - Point in time to give up
+	//! \retval true - The queue holds a value
+	//! \retval false - Timeout
+	bool waitNotEmptyUntil(std::unique_lock<std::mutex> &lk, std::chrono::steady_clock::time_point deadline) {
+		auto const ready = [this, deadline] {
+			return 0 != m_size.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= deadline;
+		};
+		for (;;) {
+			if (WaitStrategy::kBlock != m_waitStrategy) {
+				spinWait(m_waitStrategy, ready);
+			}
+
+			lock(lk);
+			if (isParking(m_waitStrategy)) {
+				return m_condPush.wait_until(lk, deadline, [this] { return !m_queue.empty(); });
+			}
+			if (!m_queue.empty() || std::chrono::steady_clock::now() >= deadline) {
+				return !m_queue.empty();
+			}
+			lk.unlock();
+		}
+	}
+
+	//! Move up to max_n values to out (lock must be held)
+	template<typename OutputIt>
+	std::size_t popSome(OutputIt out, std::size_t max_n) {
+		std::size_t popped = 0;
+		for (; popped < max_n && !m_queue.empty(); ++popped) {
+			*out++ = std::move(m_queue.front());
+			m_queue.pop();
+		}
+		publishPop();
+		m_stats.onDequeue(popped);
+		notify(m_condPop, popped);
+
+		return popped;
+	}
+
 private:
 	std::size_t m_capacity;
-	std::queue<value_type> m_queue;
+	WaitStrategy const m_waitStrategy;          //!< How consumers wait on an empty queue
+	detail::QueueStorage<value_type> m_queue;   //!< Values
+	std::atomic<std::size_t> m_size{0};         //!< Size of m_queue, readable without the lock
 	mutable std::mutex m_mutex;
 	std::condition_variable m_condPop;
 	std::condition_variable m_condPush;
+	Stats m_stats;                              //!< Statistics policy instance
+	std::atomic<Parker *> m_notifier{nullptr};  //!< Woken up on every push (see QueueSet)
+	std::unique_ptr<EventFd> m_eventFd;         //!< Readable while the queue holds values (optional)
 };
 
 } // namespace basic
@@ -133,6 +133,8 @@ static inline bool operator&(SerialDevice::ModemLine a, SerialDevice::ModemLine
 //!
 //! \brief SerialBufferDevice implements a buffered serial device.
 //! The buffer in the receive direction allows handling of received data chunks in a off-line way.
+//! It is a mirrored ring buffer, so received data is always one contiguous chunk, and data which
+//! is not removed yet (e.g. a partial frame) stays in place while ReadMore appends to it.
 //!
 class BASIC_SERVICES_EXPORT SerialBufferDevice {
 public:
@@ -159,6 +161,9 @@ public:
 	//! Data retrieval from the device
 	size_t ReadSome(uint8_t const *&);
 
+	//! Data retrieval from the device, keeping the data not removed yet
+	size_t ReadMore(uint8_t const *&);
+
 	//! Data remove (acknowledging) a data chunk
 	void Remove(size_t) noexcept;
 
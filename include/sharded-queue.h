@@ -0,0 +1,224 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_SHARDED_QUEUE_H
+#define BASIC_SERVICES_SHARDED_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <optional>
+#include <condition_variable>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "wait-strategy.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+namespace detail {
+
+//! Ticket of the calling thread, handed out once per thread in order of first use
+inline std::size_t producerTicket() {
+	static std::atomic<std::size_t> s_next{0U};
+	static thread_local std::size_t const t_ticket = s_next.fetch_add(1U, std::memory_order_relaxed);
+	return t_ticket;
+}
+
+} // namespace detail
+
+//! Template Class ShardedQueue
+//!
+//! \brief
+//! A thread safe queue for many producers, built from independent sub-queues (shards)
+//!
+//! \note
+//! Every shard has its own mutex on its own cache line, so producers on different shards never
+//! contend. Consumers drain the shards round-robin. With Sharding::kPerProducer a producer
+//! thread always pushes into the same shard, which keeps the values of each producer in FIFO
+//! order; with Sharding::kSpread the pushes of a producer rotate through the shards, which
+//! balances better but only keeps a global, approximate order.
+//! Capacity is enforced per shard (capacity / shards), Size() is a cheap approximation.
+template<typename T>
+class BASIC_SERVICES_EXPORT ShardedQueue : public noncopyable {
+public:
+	using value_type = T;
+	using reference = T &;
+	using point_type = T *;
+	using const_reference = const T &;
+
+	//! How producers pick their shard
+	enum class Sharding : uint8_t {
+		kPerProducer,   //!< one shard per producer thread, values of a producer stay in FIFO order
+		kSpread         //!< rotate through the shards on every push, no ordering guarantee
+	};
+
+public:
+	//! Constructor
+	//!
+	//! \param cap - Approximate capacity of the whole queue (0 means unlimited)
+	//! \param shards - Number of shards (0 means one per hardware thread)
+	//! \param sharding - How producers pick their shard
+	//! \param strategy - How consumers wait on an empty queue
+	explicit ShardedQueue(std::size_t cap = 0, std::size_t shards = 0, Sharding sharding = Sharding::kPerProducer,
+	                      WaitStrategy strategy = WaitStrategy::kBlock)
+			: m_count(shards ? shards : std::max(1U, std::thread::hardware_concurrency())),
+			  m_shardCapacity(cap ? (cap + m_count - 1U) / m_count : 0U),
+			  m_sharding(sharding), m_waitStrategy(strategy),
+			  m_shards(std::make_unique<Shard[]>(m_count)) {}
+
+	//! Destructor
+	~ShardedQueue() = default;
+
+	//! Query whether queue is empty (approximation)
+	bool isEmpty() const {
+		return 0U == Size();
+	}
+
+	//! Query the current amount of values in the queue (approximation)
+	std::size_t Size() const {
+		std::size_t size = 0U;
+		for (std::size_t i = 0; i < m_count; ++i) {
+			size += m_shards[i].m_size.load(std::memory_order_relaxed);
+		}
+		return size;
+	}
+
+	//! Query the capacity of the queue
+	std::size_t getCapacity() const {
+		return m_shardCapacity * m_count;
+	}
+
+	//! Query the number of shards
+	std::size_t getShards() const {
+		return m_count;
+	}
+
+	//! Push value into the queue
+	//!
+	//! \note
+	//! If the shard of the caller is full the caller blocks until a value is popped from it.
+	//! \param value - Value to be pushed
+	void Push(const_reference value) {
+		push(value);
+	}
+
+	//! Move value into the queue
+	//!
+	//! \note
+	//! If the shard of the caller is full the caller blocks until a value is popped from it.
+	//! \param value - Value to be pushed
+	void Push(value_type &&value) {
+		push(std::move(value));
+	}
+
+	//! Pop value out of the queue
+	//!
+	//! \note
+	//! If the queue is empty the caller waits until a value is pushed into the queue.
+	//! \return Value be popped
+	value_type Pop() {
+		std::optional<value_type> value;
+		auto const ready = [this, &value] { return tryPop(value); };
+		if (!spinWait(m_waitStrategy, ready)) {
+			m_notEmpty.Park(ready);
+		}
+
+		return std::move(*value);
+	}
+
+	//! Try to pop value out of the queue
+	//!
+	//! \param value - Receives the popped value
+	//! \retval true - Value popped
+	//! \retval false - Queue is empty
+	bool TryPop(reference value) {
+		std::optional<value_type> popped;
+		if (!tryPop(popped)) {
+			return false;
+		}
+
+		value = std::move(*popped);
+		return true;
+	}
+
+private:
+	//! One sub-queue
+	struct alignas(kCacheLineSize) Shard {
+		std::mutex m_mutex;
+		std::condition_variable m_condPop;          //!< Signalled when a value was popped
+		std::queue<value_type> m_queue;
+		std::size_t m_pushWaiters = 0U;             //!< Producers blocked on this full shard
+		std::atomic<std::size_t> m_size{0U};        //!< Size of m_queue, readable without the lock
+	};
+
+	//! Shard the calling producer pushes into
+	Shard &producerShard() {
+		static thread_local std::size_t t_pushes = 0U;
+		std::size_t index = detail::producerTicket();
+		if (Sharding::kSpread == m_sharding) {
+			index += t_pushes++;
+		}
+		return m_shards[index % m_count];
+	}
+
+	template<typename U>
+	void push(U &&value) {
+		Shard &shard = producerShard();
+		{
+			std::unique_lock<std::mutex> lk(shard.m_mutex);
+			while (m_shardCapacity > 0 && shard.m_queue.size() >= m_shardCapacity) {
+				++shard.m_pushWaiters;
+				shard.m_condPop.wait(lk);
+				--shard.m_pushWaiters;
+			}
+
+			shard.m_queue.push(std::forward<U>(value));
+			shard.m_size.store(shard.m_queue.size(), std::memory_order_relaxed);
+		}
+		m_notEmpty.Unpark();
+	}
+
+	//! Pop from the first non-empty shard, starting round-robin
+	bool tryPop(std::optional<value_type> &value) {
+		std::size_t const start = m_cursor.fetch_add(1U, std::memory_order_relaxed);
+		for (std::size_t i = 0; i < m_count; ++i) {
+			Shard &shard = m_shards[(start + i) % m_count];
+			if (0U == shard.m_size.load(std::memory_order_relaxed)) {
+				continue;
+			}
+
+			std::lock_guard<std::mutex> lk(shard.m_mutex);
+			if (!shard.m_queue.empty()) {
+				value.emplace(std::move(shard.m_queue.front()));
+				shard.m_queue.pop();
+				shard.m_size.store(shard.m_queue.size(), std::memory_order_relaxed);
+				if (0U != shard.m_pushWaiters) {
+					shard.m_condPop.notify_one();
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	std::size_t const m_count;                  //!< Number of shards
+	std::size_t const m_shardCapacity;          //!< Capacity of every shard (0 means unlimited)
+	Sharding const m_sharding;                  //!< How producers pick their shard
+	WaitStrategy const m_waitStrategy;          //!< How consumers wait on an empty queue
+	std::unique_ptr<Shard[]> m_shards;          //!< Shards
+
+	alignas(kCacheLineSize) std::atomic<std::size_t> m_cursor{0U}; //!< Round-robin start of consumers
+	alignas(kCacheLineSize) Parker m_notEmpty;  //!< Consumers parked on an empty queue
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_SHARDED_QUEUE_H
@@ -0,0 +1,375 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_SHM_QUEUE_H
+#define BASIC_SERVICES_SHM_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "shm-segment.h"
+#include "wait-strategy.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class ShmQueue
+//!
+//! \brief
+//! A bounded multi-producer/multi-consumer queue in a named shared memory segment, connecting processes
+//!
+//! \note
+//! The segment holds a header and a power-of-two ring of slots with per-slot sequence numbers
+//! (the same algorithm as LockFreeQueue), so a hand-off is a copy into the ring and two atomic
+//! operations, without any system call. Only callers which run out of spinning sleep on a futex
+//! word in the segment, and wakers only enter the kernel if somebody is registered as sleeping.
+//!
+//! The first process opening a name creates and initializes the segment, later ones attach to it
+//! once it is initialized; all of them must agree on T and the capacity, otherwise the instance is
+//! invalid. A process which dies in the middle of a Push or Pop may leave a slot claimed but never
+//! released, which stalls the queue for everybody. To recover, a supervisor calls Reset() while no
+//! other process uses the queue, or restarts the participants with Mode::kCreate, which replaces
+//! the segment by a fresh one.
+//!
+//! \tparam T - Value type, must be trivially copyable as values are copied between processes
+template<typename T>
+class BASIC_SERVICES_EXPORT ShmQueue : public noncopyable {
+	static_assert(std::is_trivially_copyable<T>::value, "values of a ShmQueue must be trivially copyable");
+	static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+	              "ShmQueue requires address-free atomics");
+
+public:
+	using value_type = T;
+	using reference = T &;
+	using const_reference = const T &;
+	using Mode = ShmSegment::Mode;
+
+public:
+	//! Constructor
+	//!
+	//! \param name - Name of the shared memory segment, e.g. "/acquisition"
+	//! \param cap - Capacity of the queue, rounded up to the next power of two (minimum 2)
+	//! \param mode - How the segment is opened
+	//! \param strategy - How Push and Pop wait at the full/empty edges
+	ShmQueue(char const *name, std::size_t cap, Mode mode = Mode::kOpenOrCreate,
+	         WaitStrategy strategy = WaitStrategy::kSpinPark)
+			: m_segment(name, segmentSize(roundUpPowerOfTwo(cap < 2U ? 2U : cap)), mode),
+			  m_waitStrategy(strategy) {
+		if (!m_segment) {
+			return;
+		}
+
+		auto *const header = static_cast<Header *>(m_segment.getData());
+		std::size_t const capacity = roundUpPowerOfTwo(cap < 2U ? 2U : cap);
+		if (m_segment.isCreator()) {
+			initialize(header, capacity);
+		} else if (!attach(header, capacity)) {
+			return;
+		}
+
+		m_header = header;
+		m_slots = reinterpret_cast<Slot *>(header + 1);
+		m_mask = capacity - 1U;
+	}
+
+	//! Destructor, the segment persists until unlinked
+	~ShmQueue() = default;
+
+	//! Check validity of the instance
+	//!
+	//! \retval true - Queue attached
+	//! \retval false - Failed to open the segment, or it holds a different queue
+	explicit operator bool() const noexcept { return nullptr != m_header; }
+
+	//! Remove a queue name from the system, attached processes keep using the segment
+	static bool Unlink(char const *name) {
+		return ShmSegment::Unlink(name);
+	}
+
+	//! Query whether queue is empty
+	bool isEmpty() const {
+		return 0U == Size();
+	}
+
+	//! Query whether queue is full
+	bool isFull() const {
+		return Size() >= getCapacity();
+	}
+
+	//! Query the current amount of values in the queue
+	//!
+	//! \note The value is a snapshot and may be stale under concurrent access
+	std::size_t Size() const {
+		uint64_t const dequeue = m_header->dequeuePos.load(std::memory_order_acquire);
+		uint64_t const enqueue = m_header->enqueuePos.load(std::memory_order_acquire);
+		return (enqueue > dequeue) ? std::size_t(enqueue - dequeue) : 0U;
+	}
+
+	//! Query the capacity of the queue
+	std::size_t getCapacity() const {
+		return m_mask + 1U;
+	}
+
+	//! Try to push value into the queue
+	//!
+	//! \retval true - Value pushed
+	//! \retval false - Queue is full
+	bool TryPush(const_reference value) {
+		if (!tryPush(value)) {
+			return false;
+		}
+		signal(m_header->notEmpty);
+		return true;
+	}
+
+	//! Try to pop value out of the queue
+	//!
+	//! \param value - Receives the popped value
+	//! \retval true - Value popped
+	//! \retval false - Queue is empty
+	bool TryPop(reference value) {
+		if (!tryPop(value)) {
+			return false;
+		}
+		signal(m_header->notFull);
+		return true;
+	}
+
+	//! Push value into the queue
+	//!
+	//! \note
+	//! If the queue is full the caller waits until a value is popped from the queue.
+	//! \param value - Value to be pushed
+	void Push(const_reference value) {
+		wait(m_header->notFull, [this, &value] { return tryPush(value); }, nullptr);
+		signal(m_header->notEmpty);
+	}
+
+	//! Pop value out of the queue
+	//!
+	//! \note
+	//! If the queue is empty the caller waits until a value is pushed into the queue.
+	//! \return Value be popped
+	value_type Pop() {
+		value_type value;
+		wait(m_header->notEmpty, [this, &value] { return tryPop(value); }, nullptr);
+		signal(m_header->notFull);
+		return value;
+	}
+
+	//! Pop value out of the queue with timeout
+	//!
+	//! \param value - Receives the popped value
+	//! \param timeout - Maximum time to wait for a value
+	//! \retval true - Value popped
+	//! \retval false - Timeout
+	template<typename Rep, typename Period>
+	bool Pop(reference value, std::chrono::duration<Rep, Period> const &timeout) {
+		auto const deadline = std::chrono::steady_clock::now() + timeout;
+		if (!wait(m_header->notEmpty, [this, &value] { return tryPop(value); }, &deadline)) {
+			return false;
+		}
+		signal(m_header->notFull);
+		return true;
+	}
+
+	//! Reinitialize the segment, dropping all values
+	//!
+	//! \note
+	//! Recovers a queue left inconsistent by a crashed process. No other process may use the queue
+	//! meanwhile; sleepers are woken up and go back to sleep on the fresh queue.
+	void Reset() {
+		m_header->state.store(kInitializing, std::memory_order_relaxed);
+		initialize(m_header, getCapacity());
+		wakeAll(m_header->notEmpty);
+		wakeAll(m_header->notFull);
+	}
+
+private:
+	static constexpr uint64_t kMagic = 0x6261736963736d71ULL;   //!< "basicsmq"
+	static constexpr uint32_t kVersion = 1U;
+	static constexpr uint32_t kInitializing = 0U;
+	static constexpr uint32_t kReady = 1U;
+
+	//! Time an opener waits for the creator to initialize the segment
+	static constexpr auto kInitTimeout = std::chrono::seconds(1);
+
+	//! Futex based event in shared memory
+	struct alignas(kCacheLineSize) Event {
+		std::atomic<uint32_t> sequence;     //!< Futex word, bumped on every wake-up
+		std::atomic<uint32_t> sleepers;     //!< Number of registered sleepers
+	};
+
+	//! Segment header
+	struct Header {
+		uint64_t magic;
+		uint32_t version;
+		uint32_t valueSize;
+		uint64_t capacity;
+		std::atomic<uint32_t> state;
+		alignas(kCacheLineSize) std::atomic<uint64_t> enqueuePos;
+		alignas(kCacheLineSize) std::atomic<uint64_t> dequeuePos;
+		Event notEmpty;
+		Event notFull;
+	};
+
+	//! Ring slot
+	struct Slot {
+		std::atomic<uint64_t> sequence;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+	};
+
+	static std::size_t segmentSize(std::size_t capacity) {
+		return sizeof(Header) + capacity * sizeof(Slot);
+	}
+
+	//! Initialize the segment (creator only, or on reset)
+	static void initialize(Header *header, std::size_t capacity) {
+		header->magic = kMagic;
+		header->version = kVersion;
+		header->valueSize = uint32_t(sizeof(T));
+		header->capacity = capacity;
+		header->enqueuePos.store(0U, std::memory_order_relaxed);
+		header->dequeuePos.store(0U, std::memory_order_relaxed);
+		header->notEmpty.sleepers.store(0U, std::memory_order_relaxed);
+		header->notFull.sleepers.store(0U, std::memory_order_relaxed);
+
+		auto *const slots = reinterpret_cast<Slot *>(header + 1);
+		for (std::size_t i = 0; i < capacity; ++i) {
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		header->state.store(kReady, std::memory_order_release);
+	}
+
+	//! Wait for the creator to initialize the segment and validate it
+	static bool attach(Header *header, std::size_t capacity) {
+		auto const deadline = std::chrono::steady_clock::now() + kInitTimeout;
+		while (kReady != header->state.load(std::memory_order_acquire)) {
+			if (std::chrono::steady_clock::now() >= deadline) {
+				return false;
+			}
+			std::this_thread::yield();
+		}
+
+		return kMagic == header->magic && kVersion == header->version &&
+		       sizeof(T) == header->valueSize && capacity == header->capacity;
+	}
+
+	bool tryPush(const_reference value) {
+		Slot *slot;
+		uint64_t pos = m_header->enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			slot = &m_slots[pos & m_mask];
+			uint64_t const seq = slot->sequence.load(std::memory_order_acquire);
+			auto const diff = int64_t(seq) - int64_t(pos);
+			if (0 == diff) {
+				if (m_header->enqueuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = m_header->enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		std::memcpy(&slot->storage, &value, sizeof(T));
+		slot->sequence.store(pos + 1U, std::memory_order_release);
+		return true;
+	}
+
+	bool tryPop(reference value) {
+		Slot *slot;
+		uint64_t pos = m_header->dequeuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			slot = &m_slots[pos & m_mask];
+			uint64_t const seq = slot->sequence.load(std::memory_order_acquire);
+			auto const diff = int64_t(seq) - int64_t(pos + 1U);
+			if (0 == diff) {
+				if (m_header->dequeuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = m_header->dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		std::memcpy(&value, &slot->storage, sizeof(T));
+		slot->sequence.store(pos + m_mask + 1U, std::memory_order_release);
+		return true;
+	}
+
+	//! Wait according to the wait strategy until ready() holds or the deadline passed
+	template<typename Ready>
+	bool wait(Event &event, Ready &&ready, std::chrono::steady_clock::time_point const *deadline) {
+		// ready() takes the value once it succeeds, so its result is kept and never asked again
+		bool taken = false;
+		auto const readyOrTimeout = [&ready, &taken, deadline] {
+			taken = ready();
+			return taken || (nullptr != deadline && std::chrono::steady_clock::now() >= *deadline);
+		};
+		if (spinWait(m_waitStrategy, readyOrTimeout)) {
+			return taken;
+		}
+
+		for (;;) {
+			// register before re-checking, so a waker either sees the sleeper or the sleeper sees the value
+			event.sleepers.fetch_add(1U, std::memory_order_seq_cst);
+			uint32_t const sequence = event.sequence.load(std::memory_order_seq_cst);
+			bool const done = ready();
+
+			std::chrono::nanoseconds timeout(-1);
+			if (!done && nullptr != deadline) {
+				timeout = *deadline - std::chrono::steady_clock::now();
+				if (timeout.count() <= 0) {
+					event.sleepers.fetch_sub(1U, std::memory_order_relaxed);
+					return false;
+				}
+			}
+			if (!done) {
+				detail::FutexWait(event.sequence, sequence, timeout);
+			}
+			event.sleepers.fetch_sub(1U, std::memory_order_relaxed);
+
+			if (done) {
+				return true;
+			}
+		}
+	}
+
+	//! Wake up one sleeper of an event, if any
+	static void signal(Event &event) {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (0U != event.sleepers.load(std::memory_order_relaxed)) {
+			event.sequence.fetch_add(1U, std::memory_order_release);
+			detail::FutexWake(event.sequence, 1);
+		}
+	}
+
+	//! Wake up all sleepers of an event
+	static void wakeAll(Event &event) {
+		event.sequence.fetch_add(1U, std::memory_order_release);
+		detail::FutexWake(event.sequence, INT_MAX);
+	}
+
+private:
+	ShmSegment m_segment;                   //!< Mapped shared memory segment
+	WaitStrategy const m_waitStrategy;      //!< How Push and Pop wait
+	Header *m_header = nullptr;             //!< Header in the segment
+	Slot *m_slots = nullptr;                //!< Ring in the segment, behind the header
+	std::size_t m_mask = 0U;                //!< Capacity - 1
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_SHM_QUEUE_H
@@ -0,0 +1,90 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_SHM_SEGMENT_H
+#define BASIC_SERVICES_SHM_SEGMENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class ShmSegment
+//!
+//! \brief
+//! A named shared memory segment (POSIX shm, i.e. /dev/shm on Linux) mapped into the process
+class BASIC_SERVICES_EXPORT ShmSegment : public noncopyable {
+public:
+	//! How the segment is opened
+	enum class Mode : uint8_t {
+		kOpenOrCreate,  //!< attach to an existing segment, create it if it does not exist
+		kOpen,          //!< attach to an existing segment only
+		kCreate         //!< always create a fresh segment, replacing an existing one of the same name
+	};
+
+	//! Constructor
+	//!
+	//! \param name - Name of the segment, e.g. "/my-queue"
+	//! \param size - Size of the segment in bytes
+	//! \param mode - How the segment is opened
+	ShmSegment(char const *name, std::size_t size, Mode mode = Mode::kOpenOrCreate);
+
+	//! Destructor, unmaps the segment (the segment itself persists until unlinked)
+	~ShmSegment();
+
+	//! Check validity of the instance
+	//!
+	//! \retval true - Segment mapped
+	//! \retval false - Failed to open or map the segment
+	explicit operator bool() const noexcept { return nullptr != m_data; }
+
+	//! Query the mapped memory
+	void *getData() const noexcept { return m_data; }
+
+	//! Query the size of the mapped memory
+	std::size_t getSize() const noexcept { return m_size; }
+
+	//! Query whether this instance created the segment (and has to initialize its content)
+	bool isCreator() const noexcept { return m_creator; }
+
+	//! Remove a segment name from the system, mappings of the segment stay valid
+	//!
+	//! \param name - Name of the segment
+	//! \retval true - Segment removed
+	//! \retval false - No such segment
+	static bool Unlink(char const *name);
+
+private:
+	void *m_data = nullptr;     //!< Mapped memory
+	std::size_t m_size = 0;     //!< Size of the mapped memory
+	bool m_creator = false;     //!< Segment created by this instance
+};
+
+namespace detail {
+
+//! Sleep while a 32 bit word in (possibly shared) memory holds the expected value
+//!
+//! \note Returns early on a wake-up, a signal or if the word does not hold the expected value.
+//! \param word - Word to wait on
+//! \param expected - Value the word is expected to hold
+//! \param timeout - Maximum time to sleep (negative means no limit)
+BASIC_SERVICES_EXPORT void FutexWait(std::atomic<uint32_t> &word, uint32_t expected,
+                                     std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1));
+
+//! Wake up sleepers on a 32 bit word in (possibly shared) memory
+//!
+//! \param word - Word the sleepers wait on
+//! \param count - Maximum number of sleepers to wake up
+BASIC_SERVICES_EXPORT void FutexWake(std::atomic<uint32_t> &word, int count);
+
+} // namespace detail
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_SHM_SEGMENT_H
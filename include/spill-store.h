@@ -0,0 +1,98 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_SPILL_STORE_H
+#define BASIC_SERVICES_SPILL_STORE_H
+
+#include <cstdint>
+#include <memory>
+
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class SpillStore
+//!
+//! \brief
+//! A FIFO of byte records kept in memory mapped segment files
+//!
+//! \note
+//! Records are appended sequentially to the newest segment and read back sequentially from the
+//! oldest one. Segment files are unlinked right after creation, so they never outlive the store.
+//! Fully read segments are recycled for later writes (up to a number of spare segments), and their
+//! pages are handed back to the system, so the resident memory of the store stays at a few pages
+//! regardless of the amount of spilled data. The class is not thread safe.
+class BASIC_SERVICES_EXPORT SpillStore {
+public:
+	//! Default size of a segment file
+	static constexpr std::size_t kSegmentSize = std::size_t(16U) << 20U;
+
+	//! Constructor
+	//!
+	//! \param directory - Directory of the segment files (nullptr selects the system temporary directory)
+	//! \param segmentSize - Size of a segment file, records larger than that get a segment of their own
+	//! \param spareSegments - Number of read segments kept for reuse
+	explicit SpillStore(char const *directory = nullptr, std::size_t segmentSize = kSegmentSize,
+	                    std::size_t spareSegments = 2U);
+
+	//! Destructor
+	~SpillStore();
+
+	//! Move constructor
+	SpillStore(SpillStore &&) noexcept;
+
+	//! Move assignment
+	SpillStore &operator=(SpillStore &&) noexcept;
+
+	//! Query whether store is empty
+	bool isEmpty() const noexcept;
+
+	//! Query the number of stored records
+	std::size_t Size() const noexcept;
+
+	//! Query the number of mapped segments (in use and spare)
+	std::size_t getSegments() const noexcept;
+
+	//! Reserve space for a record at the end of the store
+	//!
+	//! \param size - Maximum size of the record
+	//! \return Pointer to write the record to, nullptr if no segment could be mapped
+	uint8_t *Reserve(std::size_t size);
+
+	//! Append the record written to the space returned by Reserve
+	//!
+	//! \param size - Actual size of the record, at most the reserved size
+	void Commit(std::size_t size);
+
+	//! Append a record
+	//!
+	//! \param data - Pointer of record data
+	//! \param size - Size of record data
+	//! \retval true - Record appended
+	//! \retval false - No segment could be mapped
+	bool Append(void const *data, std::size_t size);
+
+	//! Access the oldest record in place
+	//!
+	//! \param data - Receives the pointer of record data
+	//! \param size - Receives the size of record data
+	//! \retval true - Record returned
+	//! \retval false - Store is empty
+	bool Front(uint8_t const *&data, std::size_t &size);
+
+	//! Remove the oldest record, Front() must have returned a record before
+	void PopFront();
+
+	//! Remove all records
+	void Clear();
+
+private:
+	class Impl;
+
+	std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_SPILL_STORE_H
@@ -0,0 +1,245 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_SPILLING_QUEUE_H
+#define BASIC_SERVICES_SPILLING_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <type_traits>
+#include <condition_variable>
+
+#include "noncopyable.h"
+#include "spill-store.h"
+#include "queue-storage.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class TrivialCodec
+//!
+//! \brief
+//! Codec of a SpillingQueue which stores the object representation of trivially copyable values
+//!
+//! \note
+//! A user codec provides the same three static functions: size() returns an upper bound of the
+//! encoded size, encode() writes the value and returns the actual encoded size, and decode()
+//! reconstructs the value from the encoded bytes (8 byte aligned).
+template<typename T>
+struct TrivialCodec {
+	static_assert(std::is_trivially_copyable<T>::value, "TrivialCodec requires a trivially copyable type");
+
+	static std::size_t size(T const &) noexcept {
+		return sizeof(T);
+	}
+
+	static std::size_t encode(T const &value, uint8_t *data) noexcept {
+		std::memcpy(data, &value, sizeof(T));
+		return sizeof(T);
+	}
+
+	static T decode(uint8_t const *data, std::size_t) noexcept {
+		T value;
+		std::memcpy(&value, data, sizeof(T));
+		return value;
+	}
+};
+
+//! Template Class SpillingQueue
+//!
+//! \brief
+//! A thread safe queue which overflows to disk instead of blocking producers or growing without bound
+//!
+//! \note
+//! Up to the capacity, values are held in memory. Beyond it, and as long as spilled values are
+//! pending, values are encoded into a SpillStore (memory mapped segment files, written and read
+//! sequentially, recycled once read), so the values stay in FIFO order and producers never block
+//! while the disk keeps up. Consumers take the values from memory first and then decode the
+//! spilled values in place. Only if no segment file can be created any more does a producer block,
+//! until the spilled values are drained and the memory part has room again.
+//!
+//! \tparam T - Value type
+//! \tparam Codec - Serialization of spilled values, see TrivialCodec
+template<typename T, typename Codec = TrivialCodec<T>>
+class BASIC_SERVICES_EXPORT SpillingQueue : public noncopyable {
+public:
+	using value_type = T;
+	using reference = T &;
+	using const_reference = const T &;
+
+public:
+	//! Constructor
+	//!
+	//! \param cap - Number of values held in memory, further values are spilled to disk
+	//! \param directory - Directory of the segment files (nullptr selects the system temporary directory)
+	//! \param segmentSize - Size of a segment file
+	explicit SpillingQueue(std::size_t cap, char const *directory = nullptr,
+	                       std::size_t segmentSize = SpillStore::kSegmentSize)
+			: m_capacity(cap ? cap : 1U), m_memory(m_capacity), m_spill(directory, segmentSize) {}
+
+	//! Destructor
+	~SpillingQueue() = default;
+
+	//! Query whether queue is empty
+	bool isEmpty() const {
+		return 0 == Size();
+	}
+
+	//! Query the number of values in the queue, in memory and on disk
+	std::size_t Size() const {
+		return m_size.load(std::memory_order_relaxed);
+	}
+
+	//! Query the number of values spilled to disk
+	std::size_t getSpilled() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_spill.Size();
+	}
+
+	//! Query the number of values held in memory
+	std::size_t getCapacity() const {
+		return m_capacity;
+	}
+
+	//! Clear the queue
+	void Clear() {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_memory.clear();
+		m_spill.Clear();
+		m_size.store(0, std::memory_order_relaxed);
+		m_condPop.notify_all();
+	}
+
+	//! Push value into the queue
+	//!
+	//! \note
+	//! Beyond the capacity the value is spilled to disk.
+	//! \param value - Value to be pushed
+	void Push(const_reference value) {
+		push(value);
+	}
+
+	//! Move value into the queue
+	//!
+	//! \note
+	//! Beyond the capacity the value is spilled to disk.
+	//! \param value - Value to be pushed
+	void Push(value_type &&value) {
+		push(std::move(value));
+	}
+
+	//! Pop value out of the queue
+	//!
+	//! \note
+	//! If the queue is empty the caller blocks until a value is pushed into the queue.
+	//! \return Value be popped
+	value_type Pop() {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		m_condPush.wait(lk, [this] { return !empty(); });
+
+		return pop();
+	}
+
+	//! Pop value out of the queue with timeout
+	//!
+	//! \param value - Receives the popped value
+	//! \param timeout - Maximum time to wait for a value
+	//! \retval true - Value popped
+	//! \retval false - Timeout
+	template<typename Rep, typename Period>
+	bool Pop(reference value, std::chrono::duration<Rep, Period> const &timeout) {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		if (!m_condPush.wait_for(lk, timeout, [this] { return !empty(); })) {
+			return false;
+		}
+
+		value = pop();
+		return true;
+	}
+
+	//! Try to pop value out of the queue
+	//!
+	//! \param value - Receives the popped value
+	//! \retval true - Value popped
+	//! \retval false - Queue is empty
+	bool TryPop(reference value) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		if (empty()) {
+			return false;
+		}
+
+		value = pop();
+		return true;
+	}
+
+private:
+	bool empty() const {
+		return m_memory.empty() && m_spill.isEmpty();
+	}
+
+	template<typename U>
+	void push(U &&value) {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		if (m_spill.isEmpty() && m_memory.size() < m_capacity) {
+			m_memory.push(std::forward<U>(value));
+		} else if (!spill(value)) {
+			// out of disk space, fall back to a bounded queue
+			++m_pushWaiters;
+			m_condPop.wait(lk, [this] { return m_spill.isEmpty() && m_memory.size() < m_capacity; });
+			--m_pushWaiters;
+			m_memory.push(std::forward<U>(value));
+		}
+		m_size.fetch_add(1, std::memory_order_relaxed);
+		m_condPush.notify_one();
+	}
+
+	//! Encode a value to disk (lock must be held)
+	bool spill(const_reference value) {
+		uint8_t *const data = m_spill.Reserve(Codec::size(value));
+		if (nullptr == data) {
+			return false;
+		}
+
+		m_spill.Commit(Codec::encode(value, data));
+		return true;
+	}
+
+	//! Remove the oldest value (lock must be held)
+	value_type pop() {
+		m_size.fetch_sub(1, std::memory_order_relaxed);
+		if (0 != m_pushWaiters) {
+			m_condPop.notify_all();
+		}
+
+		if (m_memory.empty()) {
+			uint8_t const *data = nullptr;
+			std::size_t size = 0;
+			m_spill.Front(data, size);
+			value_type value(Codec::decode(data, size));
+			m_spill.PopFront();
+			return value;
+		}
+
+		value_type value(std::move(m_memory.front()));
+		m_memory.pop();
+		return value;
+	}
+
+private:
+	std::size_t const m_capacity;               //!< Number of values held in memory
+	detail::QueueStorage<value_type> m_memory;  //!< Values held in memory, older than all spilled values
+	SpillStore m_spill;                         //!< Values spilled to disk
+	std::size_t m_pushWaiters = 0;              //!< Producers blocked because spilling failed
+	std::atomic<std::size_t> m_size{0};         //!< Number of values, readable without the lock
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condPop;
+	std::condition_variable m_condPush;
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_SPILLING_QUEUE_H
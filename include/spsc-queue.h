@@ -0,0 +1,211 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_SPSC_QUEUE_H
+#define BASIC_SERVICES_SPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+#include <type_traits>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "wait-strategy.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class SpscQueue
+//!
+//! \brief
+//! A wait-free queue for exactly one producer thread and one consumer thread.
+//!
+//! \note
+//! Values are constructed in place in a ring of N slots embedded in the object. Head and tail
+//! indices live on separate cache lines, and each side keeps a private copy of the opposite
+//! index which it only refreshes when the ring looks full (producer) or empty (consumer),
+//! so the hot path does not touch the other side's cache line at all.
+//! The Try* functions never wait; Push and Pop wait according to the wait strategy.
+//!
+//! \tparam T - Value type
+//! \tparam N - Capacity, must be a power of two
+template<typename T, std::size_t N>
+class BASIC_SERVICES_EXPORT SpscQueue : public noncopyable {
+	static_assert(N >= 2U && 0U == (N & (N - 1U)), "capacity must be a power of two");
+
+public:
+	using value_type = T;
+	using reference = T &;
+	using point_type = T *;
+	using const_reference = const T &;
+
+public:
+	//! Constructor
+	//!
+	//! \param strategy - How Push and Pop wait on a full or empty queue
+	explicit SpscQueue(WaitStrategy strategy = WaitStrategy::kSpinPark)
+			: m_waitStrategy(strategy) {}
+
+	//! Destructor
+	~SpscQueue() {
+		while (Front()) {
+			PopFront();
+		}
+	}
+
+	//! Query whether queue is empty
+	bool isEmpty() const {
+		return 0U == Size();
+	}
+
+	//! Query whether queue is full
+	bool isFull() const {
+		return Size() >= N;
+	}
+
+	//! Query the current amount of values in the queue
+	//!
+	//! \note The value is a snapshot and may be stale under concurrent access
+	std::size_t Size() const {
+		// head first, it never passes the tail loaded after it
+		std::size_t const head = m_head.load(std::memory_order_acquire);
+		std::size_t const size = m_tail.load(std::memory_order_acquire) - head;
+		// the producer may have refilled what the consumer took since our head snapshot
+		return (size > N) ? N : size;
+	}
+
+	//! Query the capacity of the queue
+	static constexpr std::size_t getCapacity() {
+		return N;
+	}
+
+	//! Try to construct a value in place (producer only)
+	//!
+	//! \param args - Constructor arguments of the value
+	//! \retval true - Value pushed
+	//! \retval false - Queue is full
+	template<typename... Args>
+	bool TryEmplace(Args &&... args) {
+		std::size_t const tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_cachedHead >= N) {
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+			if (tail - m_cachedHead >= N) {
+				return false;
+			}
+		}
+
+		::new(static_cast<void *>(slot(tail))) value_type(std::forward<Args>(args)...);
+		m_tail.store(tail + 1U, std::memory_order_release);
+		if (isParking(m_waitStrategy)) {
+			m_notEmpty.Unpark();
+		}
+		return true;
+	}
+
+	//! Try to push value into the queue (producer only)
+	bool TryPush(const_reference value) {
+		return TryEmplace(value);
+	}
+
+	//! Try to move value into the queue (producer only)
+	bool TryPush(value_type &&value) {
+		return TryEmplace(std::move(value));
+	}
+
+	//! Access the oldest value in place (consumer only)
+	//!
+	//! \return Pointer to the oldest value, nullptr if the queue is empty
+	point_type Front() {
+		std::size_t const head = m_head.load(std::memory_order_relaxed);
+		if (head == m_cachedTail) {
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+			if (head == m_cachedTail) {
+				return nullptr;
+			}
+		}
+
+		return slot(head);
+	}
+
+	//! Remove the oldest value, Front() must have returned a value before (consumer only)
+	void PopFront() {
+		std::size_t const head = m_head.load(std::memory_order_relaxed);
+		slot(head)->~value_type();
+		m_head.store(head + 1U, std::memory_order_release);
+		if (isParking(m_waitStrategy)) {
+			m_notFull.Unpark();
+		}
+	}
+
+	//! Try to pop value out of the queue (consumer only)
+	//!
+	//! \param value - Receives the popped value
+	//! \retval true - Value popped
+	//! \retval false - Queue is empty
+	bool TryPop(reference value) {
+		point_type const front = Front();
+		if (nullptr == front) {
+			return false;
+		}
+
+		value = std::move(*front);
+		PopFront();
+		return true;
+	}
+
+	//! Push value into the queue, waiting while it is full (producer only)
+	void Push(const_reference value) {
+		push(value);
+	}
+
+	//! Move value into the queue, waiting while it is full (producer only)
+	void Push(value_type &&value) {
+		push(std::move(value));
+	}
+
+	//! Pop value out of the queue, waiting while it is empty (consumer only)
+	value_type Pop() {
+		auto const ready = [this] { return nullptr != Front(); };
+		if (!spinWait(m_waitStrategy, ready)) {
+			m_notEmpty.Park(ready);
+		}
+
+		value_type value(std::move(*slot(m_head.load(std::memory_order_relaxed))));
+		PopFront();
+		return value;
+	}
+
+private:
+	using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+	point_type slot(std::size_t index) noexcept {
+		return reinterpret_cast<point_type>(&m_slots[index & (N - 1U)]);
+	}
+
+	template<typename U>
+	void push(U &&value) {
+		auto const ready = [this, &value] { return TryEmplace(std::forward<U>(value)); };
+		if (!spinWait(m_waitStrategy, ready)) {
+			m_notFull.Park(ready);
+		}
+	}
+
+private:
+	WaitStrategy const m_waitStrategy;                      //!< How Push and Pop wait
+
+	alignas(kCacheLineSize) std::atomic<std::size_t> m_head{0U};    //!< Next index to pop
+	std::size_t m_cachedTail = 0U;                                  //!< Consumer copy of m_tail
+
+	alignas(kCacheLineSize) std::atomic<std::size_t> m_tail{0U};    //!< Next index to push
+	std::size_t m_cachedHead = 0U;                                  //!< Producer copy of m_head
+
+	alignas(kCacheLineSize) Storage m_slots[N];                     //!< In-place value storage
+
+	alignas(kCacheLineSize) Parker m_notFull;                       //!< Parked producer
+	Parker m_notEmpty;                                              //!< Parked consumer
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_SPSC_QUEUE_H
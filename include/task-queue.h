@@ -0,0 +1,208 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_TASK_QUEUE_H
+#define BASIC_SERVICES_TASK_QUEUE_H
+
+#include <array>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "task.h"
+#include "types.h"
+#include "noncopyable.h"
+#include "queue-storage.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Priority class of a task, higher classes run first
+enum class TaskPriority : uint8_t {
+	kLow,       //!< background work such as compaction
+	kNormal,    //!< default
+	kHigh,      //!< latency sensitive work
+	kCritical   //!< work everything else waits for
+};
+
+namespace detail {
+
+//! Class TaskQueue
+//!
+//! \brief
+//! Pending tasks of a thread pool, one lane per priority class
+//!
+//! \note
+//! A lane keeps its tasks with a deadline in a heap ordered by deadline (earliest deadline first)
+//! and serves them before its tasks without one, which it keeps in FIFO order. A bitmap of non-empty
+//! lanes finds the highest one. With aging, a task gains one class per aging interval it waited,
+//! so a steady stream of urgent tasks cannot starve the lower classes. The class is not thread safe.
+class BASIC_SERVICES_NO_EXPORT TaskQueue : public noncopyable {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr std::size_t kLanes = 4U;                   //!< Number of priority classes
+	static constexpr Clock::time_point kNoDeadline = Clock::time_point::max();
+
+public:
+	//! Query whether queue is empty
+	bool empty() const noexcept {
+		return 0U == m_size;
+	}
+
+	//! Query the number of tasks
+	std::size_t size() const noexcept {
+		return m_size;
+	}
+
+	//! Query the highest class with a task, the queue must not be empty
+	TaskPriority getHighest() const noexcept {
+		return TaskPriority(63 - countLeadingZeros(m_ready));
+	}
+
+	//! Set the aging interval, zero disables aging
+	void setAging(Clock::duration interval) noexcept {
+		m_aging = interval;
+	}
+
+	//! Query whether tasks age
+	bool isAging() const noexcept {
+		return Clock::duration::zero() != m_aging;
+	}
+
+	//! Add a task
+	//!
+	//! \param task - Task
+	//! \param priority - Priority class
+	//! \param deadline - Deadline, kNoDeadline for FIFO order
+	//! \param now - Current time, only needed while aging or timed
+	//! \param timed - Whether pop() reports the time of push
+	void push(Task &&task, TaskPriority priority, Clock::time_point deadline, Clock::time_point now = {},
+	          bool timed = false) {
+		auto const index = std::min<std::size_t>(std::size_t(priority), kLanes - 1U);
+		Lane &lane = m_lanes[index];
+		if (kNoDeadline == deadline) {
+			lane.fifo.push(Entry{std::move(task), now, deadline, m_sequence++, timed});
+		} else {
+			lane.deadlines.push_back(Entry{std::move(task), now, deadline, m_sequence++, timed});
+			std::push_heap(lane.deadlines.begin(), lane.deadlines.end(), Later());
+			lane.oldestDeadline = std::min(lane.oldestDeadline, now);
+		}
+		m_ready |= uint64_t(1U) << index;
+		++m_size;
+	}
+
+	//! Take the most urgent task, the queue must not be empty
+	//!
+	//! \param now - Current time, only needed while aging
+	//! \param enqueued - Receives the time of push of a timed task, left unchanged otherwise
+	Task pop(Clock::time_point now = {}, Clock::time_point *enqueued = nullptr) {
+		std::size_t index = std::size_t(getHighest());
+		if (isAging() && 0U != (m_ready & ~(uint64_t(1U) << index))) {
+			index = mostAged(now);
+		}
+
+		Lane &lane = m_lanes[index];
+		Task task;
+		if (!lane.deadlines.empty()) {
+			std::pop_heap(lane.deadlines.begin(), lane.deadlines.end(), Later());
+			Clock::time_point const pushed = lane.deadlines.back().enqueued;
+			take(lane.deadlines.back(), task, enqueued);
+			lane.deadlines.pop_back();
+			if (lane.deadlines.empty()) {
+				lane.oldestDeadline = Clock::time_point::max();
+			} else if (isAging() && pushed == lane.oldestDeadline) {
+				lane.updateOldestDeadline();
+			}
+		} else {
+			take(lane.fifo.front(), task, enqueued);
+			lane.fifo.pop();
+		}
+		if (lane.deadlines.empty() && lane.fifo.empty()) {
+			m_ready &= ~(uint64_t(1U) << index);
+		}
+		--m_size;
+
+		return task;
+	}
+
+private:
+	//! Pending task
+	struct Entry {
+		Task task;                      //!< Task
+		Clock::time_point enqueued;     //!< Time of push while aging or timed
+		Clock::time_point deadline;     //!< Deadline, kNoDeadline if none
+		uint64_t sequence;              //!< Push order, breaks deadline ties
+		bool timed;                     //!< Whether the time of push is reported
+	};
+
+	//! Move the task out of an entry
+	static void take(Entry &entry, Task &task, Clock::time_point *enqueued) {
+		task = std::move(entry.task);
+		if (entry.timed && nullptr != enqueued) {
+			*enqueued = entry.enqueued;
+		}
+	}
+
+	//! Heap order, the earliest deadline on top
+	struct Later {
+		bool operator()(Entry const &lhs, Entry const &rhs) const noexcept {
+			return (lhs.deadline != rhs.deadline) ? lhs.deadline > rhs.deadline : lhs.sequence > rhs.sequence;
+		}
+	};
+
+	//! Tasks of one class
+	struct Lane {
+		std::vector<Entry> deadlines;   //!< Tasks with deadline, heap
+		QueueStorage<Entry> fifo;       //!< Tasks without deadline
+		Clock::time_point oldestDeadline = Clock::time_point::max(); //!< Earliest push of deadlines, while aging
+
+		//! Find the earliest push of the deadline tasks again, after it was popped
+		void updateOldestDeadline() {
+			oldestDeadline = Clock::time_point::max();
+			for (Entry const &entry : deadlines) {
+				oldestDeadline = std::min(oldestDeadline, entry.enqueued);
+			}
+		}
+
+		//! Earliest push of the tasks, the lane must not be empty
+		Clock::time_point getOldest() {
+			Clock::time_point const fifoOldest = fifo.empty() ? Clock::time_point::max() : fifo.front().enqueued;
+			return std::min(fifoOldest, deadlines.empty() ? Clock::time_point::max() : oldestDeadline);
+		}
+	};
+
+	//! Lane whose next task has the highest class after aging, ties go to the higher class
+	std::size_t mostAged(Clock::time_point now) {
+		std::size_t best = 0U;
+		int64_t bestRank = -1;
+		for (std::size_t index = 0U; index < kLanes; ++index) {
+			if (0U == (m_ready & (uint64_t(1U) << index))) {
+				continue;
+			}
+			// the oldest task ages the lane, which is not the heap head when deadlines and push order differ
+			Lane &lane = m_lanes[index];
+			Clock::time_point const enqueued = lane.getOldest();
+			int64_t const rank = int64_t(index) + int64_t((now - enqueued) / m_aging);
+			if (rank >= bestRank) {
+				best = index;
+				bestRank = rank;
+			}
+		}
+		return best;
+	}
+
+	std::array<Lane, kLanes> m_lanes;           //!< Lane per class
+	uint64_t m_ready = 0U;                      //!< Bitmap of non-empty lanes
+	std::size_t m_size = 0U;                    //!< Tasks in all lanes
+	uint64_t m_sequence = 0U;                   //!< Next push order
+	Clock::duration m_aging{};                  //!< Time after which a task gains one class, zero if off
+};
+
+} // namespace detail
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_TASK_QUEUE_H
@@ -0,0 +1,176 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_TASK_H
+#define BASIC_SERVICES_TASK_H
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Class Task
+//!
+//! \brief
+//! A move-only callable without arguments and result, the unit of work of executors
+//!
+//! \note
+//! Unlike std::function, a Task accepts move-only callables and is only ever moved, never copied.
+//! Callables of up to kInlineSize bytes with a non-throwing move constructor are stored inside
+//! the Task itself, so wrapping and queueing small closures does not allocate.
+class BASIC_SERVICES_EXPORT Task {
+public:
+	//! Size of callables stored without allocation
+	static constexpr std::size_t kInlineSize = 48U;
+
+public:
+	//! Constructor of an empty task
+	Task() noexcept = default;
+
+	//! Constructor of an empty task
+	Task(std::nullptr_t) noexcept {}
+
+	//! Constructor
+	//!
+	//! \param func - Callable, invoked without arguments
+	template<typename F, typename Func = std::decay_t<F>,
+			typename = std::enable_if_t<!std::is_same<Func, Task>::value && std::is_invocable<Func &>::value> >
+	Task(F &&func) {
+		if (isNull(func)) {
+			return;
+		}
+		if constexpr (kInline<Func>) {
+			::new(static_cast<void *>(&m_storage)) Func(std::forward<F>(func));
+			m_ops = &s_inlineOps<Func>;
+		} else {
+			*reinterpret_cast<Func **>(&m_storage) = new Func(std::forward<F>(func));
+			m_ops = &s_heapOps<Func>;
+		}
+	}
+
+	//! Move constructor
+	Task(Task &&rhs) noexcept {
+		if (nullptr != rhs.m_ops) {
+			rhs.m_ops->move(&m_storage, &rhs.m_storage);
+			m_ops = rhs.m_ops;
+			rhs.m_ops = nullptr;
+		}
+	}
+
+	//! Move assignment
+	Task &operator=(Task &&rhs) noexcept {
+		if (this != &rhs) {
+			reset();
+			if (nullptr != rhs.m_ops) {
+				rhs.m_ops->move(&m_storage, &rhs.m_storage);
+				m_ops = rhs.m_ops;
+				rhs.m_ops = nullptr;
+			}
+		}
+		return *this;
+	}
+
+	//! Destructor
+	~Task() {
+		reset();
+	}
+
+	//! Check whether the task holds a callable
+	explicit operator bool() const noexcept {
+		return nullptr != m_ops;
+	}
+
+	//! Invoke the callable, the task must not be empty
+	void operator()() {
+		m_ops->invoke(&m_storage);
+	}
+
+private:
+	//! Type specific operations
+	struct Ops {
+		void (*invoke)(void *storage);
+		void (*move)(void *dst, void *src);     //!< Move the callable from src to dst and destroy it in src
+		void (*destroy)(void *storage);
+	};
+
+	using Storage = std::aligned_storage_t<kInlineSize, alignof(std::max_align_t)>;
+
+	template<typename Func>
+	static constexpr bool kInline = sizeof(Func) <= sizeof(Storage) && alignof(Func) <= alignof(Storage) &&
+	                                std::is_nothrow_move_constructible<Func>::value;
+
+	template<typename Func>
+	static Func *inlined(void *storage) noexcept {
+		return std::launder(reinterpret_cast<Func *>(storage));
+	}
+
+	template<typename Func>
+	static Func *&allocated(void *storage) noexcept {
+		return *reinterpret_cast<Func **>(storage);
+	}
+
+	template<typename Func>
+	static constexpr Ops s_inlineOps = {
+			[](void *storage) { (*inlined<Func>(storage))(); },
+			[](void *dst, void *src) {
+				::new(dst) Func(std::move(*inlined<Func>(src)));
+				inlined<Func>(src)->~Func();
+			},
+			[](void *storage) { inlined<Func>(storage)->~Func(); }
+	};
+
+	template<typename Func>
+	static constexpr Ops s_heapOps = {
+			[](void *storage) { (*allocated<Func>(storage))(); },
+			[](void *dst, void *src) { allocated<Func>(dst) = allocated<Func>(src); },
+			[](void *storage) { delete allocated<Func>(storage); }
+	};
+
+	//! Empty function pointers and std::functions make an empty task
+	template<typename Func>
+	static bool isNull(Func const &func) noexcept {
+		if constexpr (std::is_pointer<Func>::value || std::is_member_pointer<Func>::value) {
+			return nullptr == func;
+		} else {
+			return false;
+		}
+	}
+
+	template<typename Signature>
+	static bool isNull(std::function<Signature> const &func) noexcept {
+		return !func;
+	}
+
+	void reset() noexcept {
+		if (nullptr != m_ops) {
+			m_ops->destroy(&m_storage);
+			m_ops = nullptr;
+		}
+	}
+
+	Storage m_storage;              //!< Callable or pointer to it
+	Ops const *m_ops = nullptr;     //!< Operations of the callable, nullptr when empty
+};
+
+//! Class Executor
+//!
+//! \brief
+//! Something that runs tasks, such as a ThreadPool
+class BASIC_SERVICES_EXPORT Executor {
+public:
+	//! Destructor
+	virtual ~Executor() = default;
+
+	//! Run a task, now or later
+	virtual void Execute(Task task) = 0;
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_TASK_H
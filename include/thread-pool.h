@@ -5,48 +5,212 @@
 #ifndef BASIC_SERVICES_THREAD_POOL_H
 #define BASIC_SERVICES_THREAD_POOL_H
 
+#include <atomic>
+#include <algorithm>
+#include <chrono>
 #include <mutex>
+#include <memory>
 #include <vector>
-#include <deque>
 #include <condition_variable>
 #include <string>
+#include <tuple>
+#include <type_traits>
 
 #include "noncopyable.h"
 #include "thread.h"
+#include "task.h"
+#include "future.h"
+#include "wait-strategy.h"
+#include "task-queue.h"
+#include "pool-stats.h"
+#include "work-stealing-deque.h"
 #include "basic-services_export.h"
 
 namespace basic {
 
+//! How a ThreadPool distributes tasks over its workers
+enum class Scheduling : uint8_t {
+	kShared,        //!< all workers take tasks from one locked queue
+	kWorkStealing   //!< every worker owns a deque and steals from the others when it runs dry
+};
+
 //! Class Thread Pool
-class BASIC_SERVICES_EXPORT ThreadPool : public noncopyable {
+//!
+//! \note
+//! With Scheduling::kWorkStealing, tasks Run() from outside the pool go to the shared (injection)
+//! queue, while tasks Run() from a worker go to the deque of that worker, which pops them LIFO.
+//! Idle workers take from the injection queue, then steal FIFO from a random victim. The capacity
+//! only bounds the injection queue.
+//!
+//! Workers of the pool never block on the capacity, in either scheduling, so a task which runs
+//! further tasks on its own pool, as nested parallel algorithms do, cannot wait for itself.
+//!
+//! Started with an Elasticity, the pool keeps between minThreads and maxThreads workers. It adds a
+//! worker when tasks queue up while no worker is idle, or when the queue made no progress for
+//! growWait, at most one per growInterval; a worker above the minimum retires after it found no
+//! task for keepAlive. Only parking wait strategies (kSpinPark, kBlock) let workers retire.
+//!
+//! Queued tasks run by priority class, and within a class tasks with a deadline run earliest deadline
+//! first, before the ones without. With setAging(), a task gains one class per interval it waited.
+//! Tasks a work stealing worker runs with TaskPriority::kNormal and no deadline go to its deque as
+//! before; workers look at the shared queue first while it holds a task above kNormal.
+//!
+//! With setMetrics(), the pool counts tasks and the idle time of every worker, and times how long tasks
+//! were queued and ran; getStats() returns a snapshot. In MetricsMode::kSampled only every n-th task
+//! pushed by a thread is timed, which keeps the cost of the other tasks to a few counter updates.
+class BASIC_SERVICES_EXPORT ThreadPool : public noncopyable, public Executor {
 public:
-	//! Thread function type
-	using Task = basic::Thread::Function;
+	//! Task type, move-only and allocation free for small closures
+	using Task = basic::Task;
+
+	//! Worker bounds and growth policy of an elastic pool
+	struct Elasticity {
+		unsigned int minThreads = 1U;                       //!< Workers kept while idle
+		unsigned int maxThreads = std::max(1U, std::thread::hardware_concurrency()); //!< Maximum workers
+		std::chrono::milliseconds keepAlive{60000};         //!< Idle time after which a worker above minThreads retires
+		std::size_t growDepth = 2U;                         //!< Queued tasks which add a worker while none is idle
+		std::chrono::milliseconds growWait{10};             //!< Time without progress of the queue which adds a worker
+		std::chrono::milliseconds growInterval{1};          //!< Minimum time between adding two workers
+	};
 
 	//! Constructor
-	explicit ThreadPool(std::string, uint16_t);
+	explicit ThreadPool(std::string, uint16_t, WaitStrategy = WaitStrategy::kBlock,
+	                    Scheduling = Scheduling::kShared);
 
 	//! Destructor
 	~ThreadPool();
 
-	//! Start thread pool
+	//! Set the CPUs of the workers, worker n runs on affinity[n % affinity.size()]
+	//!
+	//! \note Call before Start(), see CpuTopology::Place for common placements.
+	void setAffinity(std::vector<CpuSet> affinity);
+
+	//! Query the number of workers which failed to apply their affinity and run unpinned
+	std::size_t getUnpinnedCount() const;
+
+	//! Start thread pool with a fixed number of workers
 	void Start(unsigned int num_thread);
 
+	//! Start thread pool with a number of workers following the load
+	void Start(Elasticity const &elasticity);
+
 	//! Stop thread pool
+	//!
+	//! \note Queued tasks and tasks Run() after Stop() are dropped, futures of Submit() on them
+	//!       complete with a broken promise.
 	void Stop();
 
 	//! Retrieve name of the thread pool
 	const std::string& Name() const;
 
+	//! Query the current number of worker threads
+	std::size_t getThreadCount() const;
+
+	//! Set the time after which a queued task gains one priority class, zero (default) disables aging
+	//!
+	//! \note Call before Start().
+	void setAging(std::chrono::milliseconds interval);
+
+	//! Set what the pool measures
+	//!
+	//! \param mode - What is measured
+	//! \param sampleInterval - Every sampleInterval-th task is timed in MetricsMode::kSampled
+	//! \note Call before Start().
+	void setMetrics(MetricsMode mode, std::size_t sampleInterval = 64U);
+
+	//! Take a snapshot of the statistics, see setMetrics()
+	PoolStatsSnapshot getStats() const;
+
+	//! Forget the statistics
+	void ResetStats();
+
 	//! Push task into the thread pool
 	void Run(Task task);
+
+	//! Push task with a priority into the thread pool
+	void Run(Task task, TaskPriority priority);
+
+	//! Push task with a priority and a deadline into the thread pool
+	//!
+	//! \param deadline - Tasks of the same priority with a deadline run earliest deadline first
+	void Run(Task task, TaskPriority priority, std::chrono::steady_clock::time_point deadline);
+
+	//! Push task into the thread pool, see Executor
+	void Execute(Task task) override;
+
+	//! Push a callable into the thread pool and get a future of its result
+	//!
+	//! \param func - Callable, may be move-only
+	//! \param args - Arguments, stored by value and passed as rvalues
+	//! \return Future of the result or of the exception func throws, continuations added with
+	//!         Future::Then run on this pool
+	template<typename F, typename... Args,
+			typename R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...> >
+	Future<R> Submit(F &&func, Args &&... args) {
+		Promise<R> promise(this);
+		Future<R> future = promise.getFuture();
+		Run([promise = std::move(promise), func = std::forward<F>(func),
+			        args = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+			promise.setValueWith([&func, &args]() -> R { return std::apply(std::move(func), std::move(args)); });
+		});
+		return future;
+	}
 private:
+	struct Worker;
 
 	//! Thread function
-	void runInThread();
+	void runInThread(std::size_t slot);
+
+	//! Thread function of a work stealing worker
+	void runWorker(Worker &worker);
 
 	//! Retrieve task from task queue
-	Task take();
+	//!
+	//! \param enqueued - Receives the time of push of a timed task
+	//! \retval false - The worker retires
+	bool take(std::size_t slot, Task &task, std::chrono::steady_clock::time_point &enqueued);
+
+	//! Run a task and account for it
+	//!
+	//! \param enqueued - Time of push of a timed task, the epoch if the task is not timed
+	void runTask(std::size_t slot, Task &task, std::chrono::steady_clock::time_point enqueued);
+
+	//! Mark a worker as waiting for tasks while metrics are enabled
+	void markIdle(std::size_t slot);
+
+	//! Add a worker if the load asks for it, m_mutex must be held
+	void grow();
+
+	//! Check whether the number of workers follows the load
+	bool isElastic() const;
+
+	//! Let a worker retire if there are more than the minimum, m_mutex must be held
+	bool retire(std::size_t slot);
+
+	//! Start a worker in an unused slot, m_mutex must be held
+	void spawn();
+
+	//! Add a task to the task queue, m_mutex must be held
+	void pushBack(Task &&task, TaskPriority priority, std::chrono::steady_clock::time_point deadline, bool timed);
+
+	//! Remove the most urgent task of the task queue, m_mutex must be held
+	//!
+	//! \param enqueued - Receives the time of push of a timed task
+	Task popFront(std::chrono::steady_clock::time_point *enqueued = nullptr);
+
+	//! Find a task for a work stealing worker
+	//!
+	//! \param enqueued - Receives the time of push of a timed task
+	Task findTask(Worker &worker, std::chrono::steady_clock::time_point &enqueued);
+
+	//! Check whether any task is queued, without locking
+	bool hasTasks() const;
+
+	//! Worker of the calling thread, nullptr outside of work stealing workers
+	static Worker *&currentWorker();
+
+	//! Pool the calling thread is a worker of, nullptr outside of workers
+	static ThreadPool *&currentPool();
 
 	mutable std::mutex m_mutex;
 	std::condition_variable m_condPush;
@@ -54,12 +218,31 @@ private:
 
 	std::string m_name;
 
-	std::vector<std::unique_ptr<basic::Thread> > m_threads; //<! Thread list
-	std::deque<Task> m_tasks;                               //<! Task list
+	std::vector<std::unique_ptr<basic::Thread> > m_threads; //<! Thread list, one slot per possible worker
+	std::vector<std::size_t> m_freeSlots;                   //<! Slots without or with a retired thread
+	std::vector<CpuSet> m_affinity;                         //<! CPUs of the workers by slot
+	detail::TaskQueue m_tasks;                              //<! Task list by priority, allocation free in steady state
 
-	bool m_isRunning;
+	std::atomic_bool m_isRunning;
+	std::atomic<std::size_t> m_pending{0};                  //<! Size of m_tasks, readable without the lock
+	std::atomic_bool m_urgent{false};                       //<! m_tasks holds a task above TaskPriority::kNormal
 
 	uint16_t m_capacity;
+	WaitStrategy const m_waitStrategy;                      //<! How idle workers wait for tasks
+	Scheduling const m_scheduling;                          //<! How tasks are distributed
+
+	Elasticity m_elasticity;                                //<! Worker bounds
+	std::atomic<std::size_t> m_live{0};                     //<! Number of running workers
+	std::atomic<std::size_t> m_waiting{0};                  //<! Number of parked workers
+	std::chrono::steady_clock::time_point m_lastProgress;   //<! Last time the front of m_tasks changed
+	std::chrono::steady_clock::time_point m_lastGrow;       //<! Last time a worker was added
+
+	std::vector<std::unique_ptr<Worker> > m_workers;        //<! Work stealing workers
+	Parker m_idle;                                          //<! Idle work stealing workers
+
+	MetricsMode m_metricsMode = MetricsMode::kOff;          //<! What is measured from Start() on
+	std::size_t m_sampleInterval = 64U;                     //<! Timed tasks in MetricsMode::kSampled
+	detail::PoolStats m_stats;                              //<! Statistics
 };
 
 } // namespace basic
@@ -5,11 +5,14 @@
 #ifndef BASIC_SERVICES_THREAD_H
 #define BASIC_SERVICES_THREAD_H
 
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <string>
 #include <functional>
 
 #include "noncopyable.h"
+#include "cpu-set.h"
 
 namespace basic {
 
@@ -31,6 +34,17 @@ public:
 	//! Destructor
 	~Thread();
 
+	//! Set the CPUs the thread runs on, applied by Start() before the thread function runs
+	//!
+	//! \note A failure to apply the affinity is logged, the thread then runs unpinned, see hasAffinityFailed().
+	void setAffinity(CpuSet affinity);
+
+	//! Query whether the thread failed to apply its affinity
+	//!
+	//! \retval true - The started thread runs unpinned although an affinity was set
+	//! \retval false - No affinity was set, the thread applied it, or it is not started yet
+	bool hasAffinityFailed() const;
+
 	//! Start thread function
 	void Start();
 
@@ -47,6 +61,8 @@ private:
 	bool m_isStarted;		//!< thread started
 	bool m_isJoined;    	//!< thread joined
 	Function m_func;    	//!< thread function
+	CpuSet m_affinity;  	//!< CPUs of the thread, empty for no restriction
+	std::shared_ptr<std::atomic<bool> > m_affinityFailed;  //!< Set by the thread if applying m_affinity failed
 	std::thread m_thread;   //!< thread instance
 };
 
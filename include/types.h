@@ -13,6 +13,10 @@
 #include <cassert>
 #endif
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace basic {
 
 inline void memZero(void* p, size_t n)
@@ -20,6 +24,56 @@ inline void memZero(void* p, size_t n)
 	memset(p, 0, n);
 }
 
+//! Assumed size of a cache line, used to keep hot atomics apart
+constexpr std::size_t kCacheLineSize = 64;
+
+//! Round up to the next power of two
+inline std::size_t roundUpPowerOfTwo(std::size_t n)
+{
+	std::size_t power = 1;
+	while (power < n) {
+		power <<= 1U;
+	}
+	return power;
+}
+
+//! Count the leading zero bits of a non-zero value
+inline int countLeadingZeros(uint64_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return 63 - int(index);
+#else
+	return __builtin_clzll(value);
+#endif
+}
+
+//! Contiguous view of a sequence of objects (the subset of C++20 std::span used here)
+template<typename T>
+class Span {
+public:
+	constexpr Span() noexcept = default;
+
+	constexpr Span(T *data, std::size_t size) noexcept
+			: m_data(data), m_size(size) {}
+
+	constexpr T *data() const noexcept { return m_data; }
+
+	constexpr std::size_t size() const noexcept { return m_size; }
+
+	constexpr bool empty() const noexcept { return 0U == m_size; }
+
+	constexpr T *begin() const noexcept { return m_data; }
+
+	constexpr T *end() const noexcept { return m_data + m_size; }
+
+	constexpr T &operator[](std::size_t index) const noexcept { return m_data[index]; }
+
+private:
+	T *m_data = nullptr;
+	std::size_t m_size = 0U;
+};
 
 // Taken from google-protobuf stubs/common.h
 //
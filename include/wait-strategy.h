@@ -0,0 +1,169 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_WAIT_STRATEGY_H
+#define BASIC_SERVICES_WAIT_STRATEGY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! How a consumer waits for work to arrive
+enum class WaitStrategy : uint8_t {
+	kBusySpin,      //!< spin with a cpu pause hint, never sleep (dedicated cores only)
+	kSpinYield,     //!< spin for a while, then keep yielding the cpu, never sleep
+	kSpinPark,      //!< spin and yield for a while, then sleep until woken up
+	kBlock          //!< sleep until woken up right away
+};
+
+//! Query whether a wait strategy ends up sleeping on a condition variable
+constexpr bool isParking(WaitStrategy strategy) noexcept {
+	return WaitStrategy::kSpinPark == strategy || WaitStrategy::kBlock == strategy;
+}
+
+//! Hint the cpu that the caller is spinning
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
+//! Number of paused spins before a spinning waiter starts yielding
+constexpr unsigned int kSpinLimit = 256U;
+
+//! Number of yields before a spin-then-park waiter goes to sleep
+constexpr unsigned int kYieldLimit = 16U;
+
+//! Spin phase of a wait
+//!
+//! \brief
+//! Polls ready() according to the strategy. Non parking strategies only return once ready() holds,
+//! parking strategies give up after their spin budget so the caller can go to sleep.
+//!
+//! \param strategy - Wait strategy
+//! \param ready - Predicate telling whether the awaited condition holds
+//! \retval true - ready() holds
+//! \retval false - Spin budget exhausted, the caller should park
+template<typename Ready>
+bool spinWait(WaitStrategy strategy, Ready &&ready) {
+	switch (strategy) {
+		case WaitStrategy::kBusySpin:
+			while (!ready()) {
+				cpuRelax();
+			}
+			return true;
+
+		case WaitStrategy::kSpinYield:
+			for (unsigned int spin = 0; !ready(); ++spin) {
+				if (spin < kSpinLimit) {
+					cpuRelax();
+				} else {
+					std::this_thread::yield();
+				}
+			}
+			return true;
+
+		case WaitStrategy::kSpinPark:
+			for (unsigned int spin = 0; spin < kSpinLimit + kYieldLimit; ++spin) {
+				if (ready()) {
+					return true;
+				}
+				if (spin < kSpinLimit) {
+					cpuRelax();
+				} else {
+					std::this_thread::yield();
+				}
+			}
+			return ready();
+
+		case WaitStrategy::kBlock:
+		default:
+			return ready();
+	}
+}
+
+//! Class Parker
+//!
+//! \brief
+//! Sleeping part of a wait on state that is published through atomics.
+//!
+//! \note
+//! Waiters register themselves before re-checking the awaited condition, and wakers check for
+//! registered waiters after publishing their change (both behind a full fence). Unpark() therefore
+//! costs one fence and one load while nobody sleeps, and a wake-up can never get lost.
+class BASIC_SERVICES_EXPORT Parker : public noncopyable {
+public:
+	//! Sleep until ready() holds
+	//!
+	//! \param ready - Predicate telling whether the awaited condition holds
+	template<typename Ready>
+	void Park(Ready &&ready) {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		m_waiters.fetch_add(1U, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		while (!ready()) {
+			m_cond.wait(lk);
+		}
+		m_waiters.fetch_sub(1U, std::memory_order_relaxed);
+	}
+
+	//! Sleep until ready() holds or the deadline passed
+	//!
+	//! \param ready - Predicate telling whether the awaited condition holds
+	//! \param deadline - Point in time to give up
+	//! \return Result of the last ready() evaluation
+	template<typename Ready, typename Clock, typename Duration>
+	bool ParkUntil(Ready &&ready, std::chrono::time_point<Clock, Duration> const &deadline) {
+		std::unique_lock<std::mutex> lk(m_mutex);
+		m_waiters.fetch_add(1U, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		bool const result = m_cond.wait_until(lk, deadline, ready);
+		m_waiters.fetch_sub(1U, std::memory_order_relaxed);
+
+		return result;
+	}
+
+	//! Wake up one sleeping waiter, if any
+	void Unpark() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (0U != m_waiters.load(std::memory_order_relaxed)) {
+			std::lock_guard<std::mutex> lk(m_mutex);
+			m_cond.notify_one();
+		}
+	}
+
+	//! Wake up all sleeping waiters
+	void UnparkAll() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (0U != m_waiters.load(std::memory_order_relaxed)) {
+			std::lock_guard<std::mutex> lk(m_mutex);
+			m_cond.notify_all();
+		}
+	}
+
+private:
+	std::atomic<std::size_t> m_waiters{0U};    //!< Number of registered sleepers
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_WAIT_STRATEGY_H
@@ -0,0 +1,152 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#ifndef BASIC_SERVICES_WORK_STEALING_DEQUE_H
+#define BASIC_SERVICES_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "types.h"
+#include "noncopyable.h"
+#include "basic-services_export.h"
+
+namespace basic {
+
+//! Template Class WorkStealingDeque
+//!
+//! \brief
+//! A Chase-Lev deque of pointers: the owner thread pushes and pops at the bottom (LIFO), any other
+//! thread steals from the top (FIFO)
+//!
+//! \note
+//! Push and Pop touch no shared cache line unless the deque is nearly empty, Steal costs one CAS.
+//! The ring grows when full; replaced rings are kept until destruction because a thief may still
+//! read from them. Pop and Steal return nullptr when the deque is empty or the last item was lost
+//! to a racing thread.
+//!
+//! \tparam T - Item type, the deque stores T * and never owns the items
+template<typename T>
+class BASIC_SERVICES_EXPORT WorkStealingDeque : public noncopyable {
+public:
+	using pointer = T *;
+
+public:
+	//! Constructor
+	//!
+	//! \param cap - Initial capacity, rounded up to the next power of two
+	explicit WorkStealingDeque(std::size_t cap = 256U) {
+		m_rings.emplace_back(new Ring(roundUpPowerOfTwo(cap < 2U ? 2U : cap)));
+		m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+	}
+
+	//! Destructor
+	~WorkStealingDeque() = default;
+
+	//! Query the number of items (approximate while other threads steal)
+	std::size_t Size() const noexcept {
+		int64_t const bottom = m_bottom.load(std::memory_order_relaxed);
+		int64_t const top = m_top.load(std::memory_order_relaxed);
+		return (bottom > top) ? std::size_t(bottom - top) : 0U;
+	}
+
+	//! Query whether deque is empty (approximate while other threads steal)
+	bool isEmpty() const noexcept {
+		return 0U == Size();
+	}
+
+	//! Push an item at the bottom (owner only)
+	void Push(pointer item) {
+		int64_t const bottom = m_bottom.load(std::memory_order_relaxed);
+		int64_t const top = m_top.load(std::memory_order_acquire);
+		Ring *ring = m_ring.load(std::memory_order_relaxed);
+		if (bottom - top >= ring->m_capacity) {
+			ring = grow(ring, top, bottom);
+		}
+		ring->put(bottom, item);
+		m_bottom.store(bottom + 1, std::memory_order_release);
+	}
+
+	//! Pop the most recently pushed item (owner only)
+	pointer Pop() {
+		int64_t const bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		Ring *const ring = m_ring.load(std::memory_order_relaxed);
+		m_bottom.store(bottom, std::memory_order_seq_cst);
+		int64_t top = m_top.load(std::memory_order_seq_cst);
+
+		if (top > bottom) {
+			// empty
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		pointer item = ring->get(bottom);
+		if (top == bottom) {
+			// last item, race the thieves for it
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				item = nullptr;
+			}
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	//! Steal the least recently pushed item (any thread)
+	pointer Steal() {
+		int64_t top = m_top.load(std::memory_order_seq_cst);
+		int64_t const bottom = m_bottom.load(std::memory_order_seq_cst);
+		if (top >= bottom) {
+			return nullptr;
+		}
+
+		Ring *const ring = m_ring.load(std::memory_order_acquire);
+		pointer const item = ring->get(top);
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return nullptr;
+		}
+		return item;
+	}
+
+private:
+	//! Power-of-two ring of item pointers
+	struct Ring {
+		explicit Ring(std::size_t cap)
+				: m_capacity(int64_t(cap)), m_mask(int64_t(cap) - 1),
+				  m_slots(std::make_unique<std::atomic<pointer>[]>(cap)) {}
+
+		pointer get(int64_t index) const noexcept {
+			return m_slots[index & m_mask].load(std::memory_order_relaxed);
+		}
+
+		void put(int64_t index, pointer item) noexcept {
+			m_slots[index & m_mask].store(item, std::memory_order_relaxed);
+		}
+
+		int64_t const m_capacity;
+		int64_t const m_mask;
+		std::unique_ptr<std::atomic<pointer>[]> m_slots;
+	};
+
+	//! Replace a full ring by one of twice the size (owner only)
+	Ring *grow(Ring *ring, int64_t top, int64_t bottom) {
+		m_rings.emplace_back(new Ring(std::size_t(2 * ring->m_capacity)));
+		Ring *const bigger = m_rings.back().get();
+		for (int64_t index = top; index < bottom; ++index) {
+			bigger->put(index, ring->get(index));
+		}
+		m_ring.store(bigger, std::memory_order_release);
+		return bigger;
+	}
+
+	alignas(kCacheLineSize) std::atomic<int64_t> m_top{0};      //!< Next item to steal
+	alignas(kCacheLineSize) std::atomic<int64_t> m_bottom{0};   //!< Next free slot of the owner
+	std::atomic<Ring *> m_ring{nullptr};                        //!< Current ring
+	std::vector<std::unique_ptr<Ring> > m_rings;                //!< All rings ever used, the last is current
+};
+
+} // namespace basic
+
+#endif //BASIC_SERVICES_WORK_STEALING_DEQUE_H
@@ -0,0 +1,85 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <sched.h>
+#include <pthread.h>
+
+#include <thread>
+
+#include "cpu-set.h"
+
+namespace basic {
+
+/* ******************************************************************************************* *
+ *                                CpuSet unix implementation                                   *
+ * ******************************************************************************************* */
+
+#if defined(__linux__)
+
+namespace {
+
+//! Largest CPU number asked from the kernel
+constexpr unsigned int kMaxCpus = 4096U;
+
+} // namespace
+
+CpuSet CpuSet::getAvailable() {
+	CpuSet set;
+	cpu_set_t *const mask = CPU_ALLOC(kMaxCpus);
+	std::size_t const size = CPU_ALLOC_SIZE(kMaxCpus);
+	CPU_ZERO_S(size, mask);
+	if (0 == ::sched_getaffinity(0, size, mask)) {
+		for (unsigned int cpu = 0; cpu < kMaxCpus; ++cpu) {
+			if (CPU_ISSET_S(cpu, size, mask)) {
+				set.Add(cpu);
+			}
+		}
+	}
+	CPU_FREE(mask);
+	return set;
+}
+
+int CpuSet::getCurrentCpu() {
+	return ::sched_getcpu();
+}
+
+bool CpuSet::Apply() const {
+	std::vector<unsigned int> const cpus = getCpus();
+	if (cpus.empty()) {
+		return false;
+	}
+
+	cpu_set_t *const mask = CPU_ALLOC(cpus.back() + 1U);
+	std::size_t const size = CPU_ALLOC_SIZE(cpus.back() + 1U);
+	CPU_ZERO_S(size, mask);
+	for (unsigned int cpu : cpus) {
+		CPU_SET_S(cpu, size, mask);
+	}
+	int const result = ::pthread_setaffinity_np(::pthread_self(), size, mask);
+	CPU_FREE(mask);
+	return 0 == result;
+}
+
+#else
+
+CpuSet CpuSet::getAvailable() {
+	CpuSet set;
+	for (unsigned int cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+		set.Add(cpu);
+	}
+	return set;
+}
+
+int CpuSet::getCurrentCpu() {
+	return -1;
+}
+
+bool CpuSet::Apply() const {
+	// no portable thread pinning, leave placement to the OS
+	return false;
+}
+
+#endif
+
+} // namespace basic
@@ -0,0 +1,43 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <windows.h>
+
+#include "cpu-set.h"
+
+namespace basic {
+
+/* ******************************************************************************************* *
+ *                               CpuSet windows implementation                                 *
+ * ******************************************************************************************* */
+
+CpuSet CpuSet::getAvailable() {
+	CpuSet set;
+	DWORD_PTR process = 0;
+	DWORD_PTR system = 0;
+	if (::GetProcessAffinityMask(::GetCurrentProcess(), &process, &system)) {
+		for (unsigned int cpu = 0; cpu < 8U * sizeof(DWORD_PTR); ++cpu) {
+			if (0U != (process & (DWORD_PTR(1) << cpu))) {
+				set.Add(cpu);
+			}
+		}
+	}
+	return set;
+}
+
+int CpuSet::getCurrentCpu() {
+	return static_cast<int>(::GetCurrentProcessorNumber());
+}
+
+bool CpuSet::Apply() const {
+	DWORD_PTR mask = 0;
+	for (unsigned int cpu : getCpus()) {
+		if (cpu < 8U * sizeof(DWORD_PTR)) {
+			mask |= DWORD_PTR(1) << cpu;
+		}
+	}
+	return 0U != mask && 0U != ::SetThreadAffinityMask(::GetCurrentThread(), mask);
+}
+
+} // namespace basic
@@ -0,0 +1,133 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <cstdlib>
+#include <algorithm>
+
+#include "cpu-set.h"
+
+namespace basic {
+
+CpuSet CpuSet::Parse(std::string const &list) {
+	CpuSet set;
+	char const *cursor = list.c_str();
+	while ('\0' != *cursor && '\n' != *cursor) {
+		char *end = nullptr;
+		unsigned long const first = std::strtoul(cursor, &end, 10);
+		if (end == cursor) {
+			return CpuSet();
+		}
+		unsigned long last = first;
+		cursor = end;
+		if ('-' == *cursor) {
+			last = std::strtoul(cursor + 1, &end, 10);
+			if (end == cursor + 1 || last < first) {
+				return CpuSet();
+			}
+			cursor = end;
+		}
+		for (unsigned long cpu = first; cpu <= last; ++cpu) {
+			set.Add(static_cast<unsigned int>(cpu));
+		}
+		if (',' == *cursor) {
+			++cursor;
+		}
+	}
+	return set;
+}
+
+void CpuSet::Add(unsigned int cpu) {
+	std::size_t const word = cpu / 64U;
+	if (word >= m_words.size()) {
+		m_words.resize(word + 1U, 0U);
+	}
+	m_words[word] |= uint64_t(1) << (cpu % 64U);
+}
+
+void CpuSet::Add(CpuSet const &rhs) {
+	if (rhs.m_words.size() > m_words.size()) {
+		m_words.resize(rhs.m_words.size(), 0U);
+	}
+	for (std::size_t word = 0; word < rhs.m_words.size(); ++word) {
+		m_words[word] |= rhs.m_words[word];
+	}
+}
+
+void CpuSet::Remove(unsigned int cpu) {
+	std::size_t const word = cpu / 64U;
+	if (word < m_words.size()) {
+		m_words[word] &= ~(uint64_t(1) << (cpu % 64U));
+	}
+}
+
+bool CpuSet::has(unsigned int cpu) const {
+	std::size_t const word = cpu / 64U;
+	return word < m_words.size() && 0U != (m_words[word] & (uint64_t(1) << (cpu % 64U)));
+}
+
+std::size_t CpuSet::getCount() const {
+	std::size_t count = 0;
+	for (uint64_t word : m_words) {
+		for (; 0U != word; word &= word - 1U) {
+			++count;
+		}
+	}
+	return count;
+}
+
+bool CpuSet::isEmpty() const {
+	for (uint64_t word : m_words) {
+		if (0U != word) {
+			return false;
+		}
+	}
+	return true;
+}
+
+std::vector<unsigned int> CpuSet::getCpus() const {
+	std::vector<unsigned int> cpus;
+	for (std::size_t word = 0; word < m_words.size(); ++word) {
+		for (unsigned int bit = 0; bit < 64U; ++bit) {
+			if (0U != (m_words[word] & (uint64_t(1) << bit))) {
+				cpus.push_back(static_cast<unsigned int>(word * 64U + bit));
+			}
+		}
+	}
+	return cpus;
+}
+
+std::string CpuSet::toString() const {
+	std::string list;
+	std::vector<unsigned int> const cpus = getCpus();
+	for (std::size_t i = 0; i < cpus.size();) {
+		std::size_t last = i;
+		while (last + 1U < cpus.size() && cpus[last + 1U] == cpus[last] + 1U) {
+			++last;
+		}
+		if (!list.empty()) {
+			list += ',';
+		}
+		list += std::to_string(cpus[i]);
+		if (last != i) {
+			list += '-';
+			list += std::to_string(cpus[last]);
+		}
+		i = last + 1U;
+	}
+	return list;
+}
+
+bool CpuSet::operator==(CpuSet const &rhs) const {
+	std::size_t const words = std::max(m_words.size(), rhs.m_words.size());
+	for (std::size_t word = 0; word < words; ++word) {
+		uint64_t const lhsWord = (word < m_words.size()) ? m_words[word] : 0U;
+		uint64_t const rhsWord = (word < rhs.m_words.size()) ? rhs.m_words[word] : 0U;
+		if (lhsWord != rhsWord) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace basic
@@ -0,0 +1,22 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include "cpu-topology.h"
+
+namespace basic {
+
+/* ******************************************************************************************* *
+ *                            CpuTopology generic implementation                               *
+ * ******************************************************************************************* */
+
+CpuTopology CpuTopology::Detect() {
+	// no topology information, every CPU is a core of its own on one node
+	std::vector<Cpu> cpus;
+	for (unsigned int id : CpuSet::getAvailable().getCpus()) {
+		cpus.push_back(Cpu{id, id, 0U, 0U});
+	}
+	return CpuTopology(std::move(cpus));
+}
+
+} // namespace basic
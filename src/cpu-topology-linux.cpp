@@ -0,0 +1,77 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <fstream>
+#include <string>
+
+#include "cpu-topology.h"
+
+namespace basic {
+
+/* ******************************************************************************************* *
+ *                               local implementation                                          *
+ * ******************************************************************************************* */
+
+namespace {
+
+//! Read the first line of a sysfs file
+bool ReadLine(std::string const &path, std::string &line) {
+	std::ifstream file(path);
+	return static_cast<bool>(std::getline(file, line));
+}
+
+//! Read a number from a sysfs file
+unsigned int ReadNumber(std::string const &path, unsigned int fallback) {
+	std::string line;
+	if (!ReadLine(path, line) || line.empty() || '-' == line[0]) {
+		return fallback;
+	}
+	return static_cast<unsigned int>(std::stoul(line));
+}
+
+//! Largest node number probed in sysfs
+constexpr unsigned int kMaxNodes = 1024U;
+
+} // namespace
+
+/* ******************************************************************************************* *
+ *                             CpuTopology linux implementation                                *
+ * ******************************************************************************************* */
+
+CpuTopology CpuTopology::Detect() {
+	CpuSet const available = CpuSet::getAvailable();
+	std::string const cpuDir = "/sys/devices/system/cpu/cpu";
+
+	std::vector<Cpu> cpus;
+	for (unsigned int id : available.getCpus()) {
+		std::string const topology = cpuDir + std::to_string(id) + "/topology/";
+		Cpu cpu{};
+		cpu.id = id;
+		cpu.package = ReadNumber(topology + "physical_package_id", 0U);
+		// core ids repeat on every package, make them unique
+		cpu.core = (cpu.package << 16U) | ReadNumber(topology + "core_id", id);
+		cpu.node = 0;
+		cpus.push_back(cpu);
+	}
+
+	// the node directories list their CPUs, numbering may have gaps
+	std::size_t found = 0;
+	for (unsigned int node = 0; node < kMaxNodes && found < cpus.size(); ++node) {
+		std::string list;
+		if (!ReadLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", list)) {
+			continue;
+		}
+		CpuSet const nodeCpus = CpuSet::Parse(list);
+		for (Cpu &cpu : cpus) {
+			if (nodeCpus.has(cpu.id)) {
+				cpu.node = node;
+				++found;
+			}
+		}
+	}
+
+	return CpuTopology(std::move(cpus));
+}
+
+} // namespace basic
@@ -0,0 +1,122 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <algorithm>
+
+#include "cpu-topology.h"
+
+namespace basic {
+
+CpuTopology::CpuTopology(std::vector<Cpu> cpus)
+		: m_cpus(std::move(cpus)) {
+	std::sort(m_cpus.begin(), m_cpus.end(), [](Cpu const &lhs, Cpu const &rhs) {
+		if (lhs.node != rhs.node) {
+			return lhs.node < rhs.node;
+		}
+		if (lhs.package != rhs.package) {
+			return lhs.package < rhs.package;
+		}
+		if (lhs.core != rhs.core) {
+			return lhs.core < rhs.core;
+		}
+		return lhs.id < rhs.id;
+	});
+
+	// number the nodes densely
+	for (Cpu &cpu : m_cpus) {
+		if (m_nodes.empty() || m_nodes.back() != cpu.node) {
+			m_nodes.push_back(cpu.node);
+		}
+		cpu.node = static_cast<unsigned int>(m_nodes.size() - 1U);
+	}
+}
+
+std::size_t CpuTopology::getNodeCount() const {
+	return std::max<std::size_t>(1U, m_nodes.size());
+}
+
+std::vector<CpuTopology::Cpu> const &CpuTopology::getCpus() const {
+	return m_cpus;
+}
+
+CpuSet CpuTopology::getNodeCpus(std::size_t node) const {
+	CpuSet set;
+	for (Cpu const &cpu : m_cpus) {
+		if (cpu.node == node) {
+			set.Add(cpu.id);
+		}
+	}
+	return set;
+}
+
+std::size_t CpuTopology::getNode(int cpu) const {
+	for (Cpu const &candidate : m_cpus) {
+		if (cpu >= 0 && candidate.id == static_cast<unsigned int>(cpu)) {
+			return candidate.node;
+		}
+	}
+	return 0;
+}
+
+std::size_t CpuTopology::getCurrentNode() const {
+	return getNode(CpuSet::getCurrentCpu());
+}
+
+std::vector<CpuSet> CpuTopology::getCores(Placement placement, std::size_t node) const {
+	// cores per node, m_cpus lists the CPUs of a core next to each other
+	std::vector<std::vector<CpuSet> > nodes(getNodeCount());
+	for (std::size_t i = 0; i < m_cpus.size(); ++i) {
+		Cpu const &cpu = m_cpus[i];
+		bool const sameCore = i > 0 && m_cpus[i - 1U].node == cpu.node &&
+		                      m_cpus[i - 1U].package == cpu.package && m_cpus[i - 1U].core == cpu.core;
+		if (!sameCore) {
+			nodes[cpu.node].emplace_back();
+		}
+		nodes[cpu.node].back().Add(cpu.id);
+	}
+
+	std::vector<CpuSet> cores;
+	switch (placement) {
+		case Placement::kNode:
+			if (node < nodes.size()) {
+				cores = nodes[node];
+			}
+			break;
+
+		case Placement::kScatter:
+			for (std::size_t index = 0, added = 1; 0 != added; ++index) {
+				added = 0;
+				for (auto const &nodeCores : nodes) {
+					if (index < nodeCores.size()) {
+						cores.push_back(nodeCores[index]);
+						++added;
+					}
+				}
+			}
+			break;
+
+		case Placement::kCompact:
+		default:
+			for (auto const &nodeCores : nodes) {
+				cores.insert(cores.end(), nodeCores.begin(), nodeCores.end());
+			}
+			break;
+	}
+	return cores;
+}
+
+std::vector<CpuSet> CpuTopology::Place(Placement placement, std::size_t count, std::size_t node) const {
+	std::vector<CpuSet> const cores = getCores(placement, node);
+	if (0 == count) {
+		count = cores.size();
+	}
+
+	std::vector<CpuSet> sets(count);
+	for (std::size_t worker = 0; worker < count && !cores.empty(); ++worker) {
+		sets[worker] = cores[worker % cores.size()];
+	}
+	return sets;
+}
+
+} // namespace basic
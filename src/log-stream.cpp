@@ -3,6 +3,7 @@
 //
 
 #include <algorithm>
+#include <limits>
 #include "log-stream.h"
 
 using namespace basic;
@@ -0,0 +1,77 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <atomic>
+#include <string>
+
+#include "mirrored-ring-buffer.h"
+
+namespace basic {
+
+/* ******************************************************************************************* *
+ *                               local implementation                                          *
+ * ******************************************************************************************* */
+
+namespace {
+
+//! Create an anonymous shared memory file of the given size
+int CreateMemoryFile(std::size_t size) {
+#if defined(__linux__)
+	int const fd = ::memfd_create("basic-mirrored-ring", MFD_CLOEXEC);
+#else
+	static std::atomic<unsigned int> s_counter{0U};
+	std::string const name = "/basic-mrb-" + std::to_string(::getpid()) + "-" + std::to_string(s_counter++);
+	int const fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (fd >= 0) {
+		::shm_unlink(name.c_str());
+	}
+#endif
+	if (fd >= 0 && 0 != ::ftruncate(fd, off_t(size))) {
+		::close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+} // namespace
+
+/* ******************************************************************************************* *
+ *                          MirroredRingBuffer unix implementation                             *
+ * ******************************************************************************************* */
+
+MirroredRingBuffer::MirroredRingBuffer(std::size_t size) {
+	auto const page = std::size_t(::sysconf(_SC_PAGESIZE));
+	size = (size ? (size + page - 1U) / page : 1U) * page;
+
+	int const fd = CreateMemoryFile(size);
+	if (fd < 0) {
+		return;
+	}
+
+	// reserve the address range of both mappings, then map the file twice into it
+	void *const base = ::mmap(nullptr, 2U * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (MAP_FAILED != base) {
+		auto *const first = static_cast<uint8_t *>(base);
+		if (MAP_FAILED != ::mmap(first, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) &&
+		    MAP_FAILED != ::mmap(first + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0)) {
+			m_data = first;
+			m_capacity = size;
+		} else {
+			::munmap(base, 2U * size);
+		}
+	}
+	::close(fd);
+}
+
+MirroredRingBuffer::~MirroredRingBuffer() {
+	if (nullptr != m_data) {
+		::munmap(m_data, 2U * m_capacity);
+	}
+}
+
+} // namespace basic
@@ -0,0 +1,69 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <windows.h>
+
+#include "mirrored-ring-buffer.h"
+
+namespace basic {
+
+/* ******************************************************************************************* *
+ *                        MirroredRingBuffer windows implementation                            *
+ * ******************************************************************************************* */
+
+namespace {
+
+//! Number of attempts to map both views while other threads may grab the address range
+constexpr int kMapAttempts = 16;
+
+} // namespace
+
+MirroredRingBuffer::MirroredRingBuffer(std::size_t size) {
+	SYSTEM_INFO info;
+	::GetSystemInfo(&info);
+	std::size_t const granularity = info.dwAllocationGranularity;
+	size = (size ? (size + granularity - 1U) / granularity : 1U) * granularity;
+
+	auto const size64 = uint64_t(size);
+	HANDLE const mapping = ::CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+	                                            DWORD(size64 >> 32U), DWORD(size64), nullptr);
+	if (nullptr == mapping) {
+		return;
+	}
+
+	for (int attempt = 0; attempt < kMapAttempts && nullptr == m_data; ++attempt) {
+		// find a free address range of both views, release it and map the views into it
+		void *const base = ::VirtualAlloc(nullptr, 2U * size, MEM_RESERVE, PAGE_NOACCESS);
+		if (nullptr == base) {
+			break;
+		}
+		::VirtualFree(base, 0, MEM_RELEASE);
+
+		auto *const first = static_cast<uint8_t *>(base);
+		void *const view1 = ::MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, first);
+		if (nullptr == view1) {
+			continue;
+		}
+		void *const view2 = ::MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, first + size);
+		if (nullptr == view2) {
+			::UnmapViewOfFile(view1);
+			continue;
+		}
+
+		m_data = first;
+		m_capacity = size;
+	}
+
+	// the views keep the mapping alive
+	::CloseHandle(mapping);
+}
+
+MirroredRingBuffer::~MirroredRingBuffer() {
+	if (nullptr != m_data) {
+		::UnmapViewOfFile(m_data + m_capacity);
+		::UnmapViewOfFile(m_data);
+	}
+}
+
+} // namespace basic
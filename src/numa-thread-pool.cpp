@@ -0,0 +1,66 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include "numa-thread-pool.h"
+
+namespace basic {
+
+NumaThreadPool::NumaThreadPool(std::string const &name, uint16_t capacity, WaitStrategy strategy,
+                               Scheduling scheduling)
+		: m_topology(CpuTopology::Detect()) {
+	for (std::size_t node = 0; node < m_topology.getNodeCount(); ++node) {
+		m_pools.emplace_back(new ThreadPool(name + "/" + std::to_string(node), capacity, strategy, scheduling));
+	}
+}
+
+NumaThreadPool::~NumaThreadPool() = default;
+
+void NumaThreadPool::Start(unsigned int threadsPerNode) {
+	for (std::size_t node = 0; node < m_pools.size(); ++node) {
+		std::vector<CpuSet> affinity = m_topology.Place(Placement::kNode, threadsPerNode, node);
+		auto const threads = static_cast<unsigned int>(affinity.size());
+		m_pools[node]->setAffinity(std::move(affinity));
+		m_pools[node]->Start(threads);
+	}
+}
+
+void NumaThreadPool::Stop() {
+	for (auto &pool : m_pools) {
+		pool->Stop();
+	}
+}
+
+std::size_t NumaThreadPool::getNodeCount() const {
+	return m_pools.size();
+}
+
+CpuTopology const &NumaThreadPool::getTopology() const {
+	return m_topology;
+}
+
+ThreadPool &NumaThreadPool::getPool(std::size_t node) {
+	return *m_pools[node < m_pools.size() ? node : node % m_pools.size()];
+}
+
+std::size_t NumaThreadPool::getUnpinnedCount() const {
+	std::size_t count = 0;
+	for (auto const &pool : m_pools) {
+		count += pool->getUnpinnedCount();
+	}
+	return count;
+}
+
+void NumaThreadPool::Run(std::size_t node, Task task) {
+	getPool(node).Run(std::move(task));
+}
+
+void NumaThreadPool::Run(Task task) {
+	getPool(m_topology.getCurrentNode()).Run(std::move(task));
+}
+
+void NumaThreadPool::Execute(Task task) {
+	Run(std::move(task));
+}
+
+} // namespace basic
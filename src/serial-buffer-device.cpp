@@ -33,6 +33,16 @@ size_t SerialBufferDevice::ReadSome(uint8_t const *&buffer) {
 	return !m_impl ? 0 : m_impl->ReadSome(buffer);
 }
 
+//! Data retrieval from the device, keeping the data not removed yet
+//!
+//! \brief This function reads more data from the device and appends it to the data
+//!			not removed yet, e.g. to complete a partial frame.
+//! \param buffer - Reference to all received data
+//! \return - Size of all received data
+size_t SerialBufferDevice::ReadMore(uint8_t const *&buffer) {
+	return !m_impl ? 0 : m_impl->ReadMore(buffer);
+}
+
 //! Data remove (acknowledging) a data chunk
 //!
 //! \brief This function acknowledges a data chunk from the device,
@@ -0,0 +1,112 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include <cerrno>
+#include <ctime>
+#include <thread>
+
+#include "shm-segment.h"
+
+namespace basic {
+
+/* ******************************************************************************************* *
+ *                                  ShmSegment implementation                                  *
+ * ******************************************************************************************* */
+
+namespace {
+
+//! Time an opener waits for the creator to size a fresh segment
+constexpr auto kSizeTimeout = std::chrono::seconds(1);
+
+} // namespace
+
+ShmSegment::ShmSegment(char const *name, std::size_t size, Mode mode) {
+	if (Mode::kCreate == mode) {
+		::shm_unlink(name);
+	}
+
+	int fd = -1;
+	if (Mode::kOpen != mode) {
+		fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+		m_creator = (fd >= 0);
+	}
+	if (fd < 0 && Mode::kCreate != mode) {
+		fd = ::shm_open(name, O_RDWR, 0600);
+	}
+	if (fd < 0) {
+		return;
+	}
+
+	bool sized = false;
+	if (m_creator) {
+		sized = (0 == ::ftruncate(fd, off_t(size)));
+	} else {
+		// the creator may not have sized the segment yet
+		auto const deadline = std::chrono::steady_clock::now() + kSizeTimeout;
+		struct stat st{};
+		while (0 == ::fstat(fd, &st) && std::size_t(st.st_size) < size && std::chrono::steady_clock::now() < deadline) {
+			std::this_thread::yield();
+		}
+		sized = (std::size_t(st.st_size) >= size);
+	}
+
+	if (sized) {
+		void *const data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (MAP_FAILED != data) {
+			m_data = data;
+			m_size = size;
+		}
+	}
+	::close(fd);
+
+	if (nullptr == m_data && m_creator) {
+		::shm_unlink(name);
+	}
+}
+
+ShmSegment::~ShmSegment() {
+	if (nullptr != m_data) {
+		::munmap(m_data, m_size);
+	}
+}
+
+bool ShmSegment::Unlink(char const *name) {
+	return 0 == ::shm_unlink(name);
+}
+
+/* ******************************************************************************************* *
+ *                                     Futex implementation                                    *
+ * ******************************************************************************************* */
+
+namespace detail {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32 bit word");
+
+void FutexWait(std::atomic<uint32_t> &word, uint32_t expected, std::chrono::nanoseconds timeout) {
+	struct timespec ts{};
+	struct timespec *pts = nullptr;
+	if (timeout.count() >= 0) {
+		ts.tv_sec = time_t(timeout.count() / 1000000000);
+		ts.tv_nsec = long(timeout.count() % 1000000000);
+		pts = &ts;
+	}
+
+	// no FUTEX_PRIVATE_FLAG, the word may be shared with other processes
+	::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, expected, pts, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t> &word, int count) {
+	::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
+} // namespace detail
+
+} // namespace basic
@@ -0,0 +1,83 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "spill-segment.h"
+
+namespace basic {
+
+namespace detail {
+
+/* ******************************************************************************************* *
+ *                                 SpillSegment unix implementation                            *
+ * ******************************************************************************************* */
+
+bool MapSegment(char const *directory, SpillSegment &segment) {
+	if (nullptr == directory) {
+		directory = std::getenv("TMPDIR");
+	}
+	std::string path = (nullptr != directory && '\0' != *directory) ? directory : "/tmp";
+	path += "/basic-spill-XXXXXX";
+
+	int const fd = ::mkstemp(&path[0]);
+	if (fd < 0) {
+		return false;
+	}
+	// the file lives as long as the mapping
+	::unlink(path.c_str());
+
+	// allocate the blocks now: a write through the mapping into a hole of a full disk raises SIGBUS
+	void *data = MAP_FAILED;
+	if (0 == ::posix_fallocate(fd, 0, off_t(segment.size))) {
+		data = ::mmap(nullptr, segment.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+	if (MAP_FAILED == data) {
+		::close(fd);
+		return false;
+	}
+
+	::madvise(data, segment.size, MADV_SEQUENTIAL);
+	segment.data = static_cast<uint8_t *>(data);
+	segment.used = 0;
+	segment.fd = fd;
+	return true;
+}
+
+bool DropSegment(SpillSegment &segment) {
+#ifdef MADV_REMOVE
+	// frees the pages and the file blocks, so consumed data is never written back; the blocks are
+	// allocated again for the next writes, which fails instead of SIGBUS once the disk is full
+	if (0 == ::madvise(segment.data, segment.size, MADV_REMOVE)) {
+		return 0 == ::posix_fallocate(segment.fd, 0, off_t(segment.size));
+	}
+#endif
+	::madvise(segment.data, segment.size, MADV_DONTNEED);
+	return true;
+}
+
+void EvictSegment(SpillSegment &segment) {
+	// dirty pages of a shared mapping move to the page cache and get written back from there
+	::madvise(segment.data, segment.size, MADV_DONTNEED);
+}
+
+void UnmapSegment(SpillSegment &segment) {
+	if (nullptr != segment.data) {
+		::munmap(segment.data, segment.size);
+		segment.data = nullptr;
+	}
+	if (segment.fd >= 0) {
+		::close(segment.fd);
+		segment.fd = -1;
+	}
+}
+
+} // namespace detail
+
+} // namespace basic
@@ -0,0 +1,87 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <windows.h>
+
+#include <string>
+
+#include "spill-segment.h"
+
+namespace basic {
+
+namespace detail {
+
+/* ******************************************************************************************* *
+ *                                SpillSegment windows implementation                          *
+ * ******************************************************************************************* */
+
+bool MapSegment(char const *directory, SpillSegment &segment) {
+	char folder[MAX_PATH + 1];
+	if (nullptr == directory || '\0' == *directory) {
+		if (0 == ::GetTempPathA(sizeof(folder), folder)) {
+			return false;
+		}
+		directory = folder;
+	}
+
+	char path[MAX_PATH + 1];
+	if (0 == ::GetTempFileNameA(directory, "bsp", 0, path)) {
+		return false;
+	}
+
+	// the file lives as long as the mapping
+	HANDLE const file = ::CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+	                                  FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE | FILE_FLAG_SEQUENTIAL_SCAN,
+	                                  nullptr);
+	if (INVALID_HANDLE_VALUE == file) {
+		::DeleteFileA(path);
+		return false;
+	}
+
+	// set the size before mapping: the file is not sparse, so its clusters are allocated here and a
+	// full disk fails the segment instead of a write through the mapping
+	auto const size = uint64_t(segment.size);
+	LARGE_INTEGER end;
+	end.QuadPart = LONGLONG(size);
+	HANDLE mapping = nullptr;
+	if (::SetFilePointerEx(file, end, nullptr, FILE_BEGIN) && ::SetEndOfFile(file)) {
+		mapping = ::CreateFileMappingA(file, nullptr, PAGE_READWRITE, DWORD(size >> 32U), DWORD(size), nullptr);
+	}
+	void *data = nullptr;
+	if (nullptr != mapping) {
+		data = ::MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, segment.size);
+		::CloseHandle(mapping);
+	}
+	::CloseHandle(file);
+	if (nullptr == data) {
+		return false;
+	}
+
+	segment.data = static_cast<uint8_t *>(data);
+	segment.used = 0;
+	return true;
+}
+
+bool DropSegment(SpillSegment &segment) {
+	// removes the pages from the working set, the content is dropped by being overwritten, the
+	// clusters stay allocated
+	::VirtualUnlock(segment.data, segment.size);
+	return true;
+}
+
+void EvictSegment(SpillSegment &segment) {
+	::FlushViewOfFile(segment.data, segment.size);
+	::VirtualUnlock(segment.data, segment.size);
+}
+
+void UnmapSegment(SpillSegment &segment) {
+	if (nullptr != segment.data) {
+		::UnmapViewOfFile(segment.data);
+		segment.data = nullptr;
+	}
+}
+
+} // namespace detail
+
+} // namespace basic
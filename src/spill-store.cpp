@@ -0,0 +1,225 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "spill-store.h"
+#include "spill-segment.h"
+
+namespace basic {
+
+/* ******************************************************************************************* *
+ *                                  SpillStore::Impl definition                                *
+ * ******************************************************************************************* */
+
+//! SpillStore::Impl - Spill store implementation
+//!
+//! Every record is stored as a header holding its size followed by the record data, padded to
+//! kAlignment, so record data is always suitably aligned for the codec reading it in place.
+//! The oldest segment is the read segment, the newest one the write segment.
+class BASIC_SERVICES_NO_EXPORT SpillStore::Impl {
+private:
+	static constexpr std::size_t kAlignment = 8U;           //!< Alignment of records
+	static constexpr std::size_t kHeader = kAlignment;      //!< Size of a record header
+
+	std::string const m_directory;                  //!< Directory of segment files
+	std::size_t const m_segmentSize;                //!< Size of a regular segment
+	std::size_t const m_spareSegments;              //!< Number of segments kept for reuse
+	std::deque<detail::SpillSegment> m_segments;    //!< Segments in use, oldest first
+	std::vector<detail::SpillSegment> m_spare;      //!< Segments kept for reuse
+	std::size_t m_readOffset = 0;                   //!< Offset of the oldest record in the read segment
+	std::size_t m_count = 0;                        //!< Number of records
+	std::size_t m_reserved = 0;                     //!< Size of the pending reservation
+
+	static std::size_t stride(std::size_t size) noexcept {
+		return kHeader + (size + kAlignment - 1U) / kAlignment * kAlignment;
+	}
+
+	//! Return a segment to the spare list or to the system
+	void recycle(detail::SpillSegment &segment) {
+		if (m_spare.size() < m_spareSegments && m_segmentSize == segment.size && detail::DropSegment(segment)) {
+			segment.used = 0;
+			m_spare.push_back(segment);
+		} else {
+			detail::UnmapSegment(segment);
+		}
+	}
+
+	//! Start a new write segment with room for need bytes
+	bool append(std::size_t need) {
+		if (m_segments.size() > 1U) {
+			// the completed write segment is only read back later, do not keep its pages resident
+			detail::EvictSegment(m_segments.back());
+		}
+
+		detail::SpillSegment segment;
+		if (need <= m_segmentSize && !m_spare.empty()) {
+			segment = m_spare.back();
+			m_spare.pop_back();
+		} else {
+			segment.size = std::max(m_segmentSize, need);
+			if (!detail::MapSegment(m_directory.empty() ? nullptr : m_directory.c_str(), segment)) {
+				return false;
+			}
+		}
+		m_segments.push_back(segment);
+
+		return true;
+	}
+
+public:
+	Impl(char const *directory, std::size_t segmentSize, std::size_t spareSegments)
+			: m_directory(directory ? directory : ""),
+			  m_segmentSize((std::max<std::size_t>(segmentSize, 4096U) + kAlignment - 1U) / kAlignment * kAlignment),
+			  m_spareSegments(spareSegments) {}
+
+	~Impl() {
+		for (auto &segment : m_segments) {
+			detail::UnmapSegment(segment);
+		}
+		for (auto &segment : m_spare) {
+			detail::UnmapSegment(segment);
+		}
+	}
+
+	bool IsEmpty() const noexcept { return 0 == m_count; }
+
+	std::size_t Size() const noexcept { return m_count; }
+
+	std::size_t Segments() const noexcept { return m_segments.size() + m_spare.size(); }
+
+	uint8_t *Reserve(std::size_t size) {
+		std::size_t const need = stride(size);
+		if (m_segments.empty() || m_segments.back().used + need > m_segments.back().size) {
+			if (!append(need)) {
+				return nullptr;
+			}
+		}
+
+		m_reserved = size;
+		return m_segments.back().data + m_segments.back().used + kHeader;
+	}
+
+	void Commit(std::size_t size) {
+		detail::SpillSegment &segment = m_segments.back();
+		size = std::min(size, m_reserved);
+		std::memcpy(segment.data + segment.used, &size, sizeof(size));
+		segment.used += stride(size);
+		m_reserved = 0;
+		++m_count;
+	}
+
+	bool Front(uint8_t const *&data, std::size_t &size) {
+		if (0 == m_count) {
+			return false;
+		}
+
+		if (m_readOffset == m_segments.front().used) {
+			recycle(m_segments.front());
+			m_segments.pop_front();
+			m_readOffset = 0;
+		}
+
+		detail::SpillSegment const &segment = m_segments.front();
+		std::memcpy(&size, segment.data + m_readOffset, sizeof(size));
+		data = segment.data + m_readOffset + kHeader;
+		return true;
+	}
+
+	void PopFront() {
+		std::size_t size;
+		std::memcpy(&size, m_segments.front().data + m_readOffset, sizeof(size));
+		m_readOffset += stride(size);
+
+		if (0 == --m_count) {
+			// rewind, so a store which keeps running empty writes to the same, resident pages
+			rewind(false);
+		}
+	}
+
+	void Clear() {
+		rewind(true);
+	}
+
+	//! Drop all records, keeping the write segment
+	void rewind(bool drop) {
+		while (m_segments.size() > 1U) {
+			recycle(m_segments.front());
+			m_segments.pop_front();
+		}
+		if (!m_segments.empty()) {
+			if (drop && !detail::DropSegment(m_segments.front())) {
+				// out of disk space, the next record maps a new segment or fails
+				detail::UnmapSegment(m_segments.front());
+				m_segments.pop_front();
+			} else {
+				m_segments.front().used = 0;
+			}
+		}
+		m_readOffset = 0;
+		m_count = 0;
+	}
+};
+
+/* ******************************************************************************************* *
+ *                                  SpillStore implementation                                  *
+ * ******************************************************************************************* */
+
+SpillStore::SpillStore(char const *directory, std::size_t segmentSize, std::size_t spareSegments)
+		: m_impl(std::make_unique<Impl>(directory, segmentSize, spareSegments)) {}
+
+SpillStore::~SpillStore() = default;
+
+SpillStore::SpillStore(SpillStore &&) noexcept = default;
+
+SpillStore &SpillStore::operator=(SpillStore &&) noexcept = default;
+
+bool SpillStore::isEmpty() const noexcept {
+	return m_impl->IsEmpty();
+}
+
+std::size_t SpillStore::Size() const noexcept {
+	return m_impl->Size();
+}
+
+std::size_t SpillStore::getSegments() const noexcept {
+	return m_impl->Segments();
+}
+
+uint8_t *SpillStore::Reserve(std::size_t size) {
+	return m_impl->Reserve(size);
+}
+
+void SpillStore::Commit(std::size_t size) {
+	m_impl->Commit(size);
+}
+
+bool SpillStore::Append(void const *data, std::size_t size) {
+	uint8_t *const record = m_impl->Reserve(size);
+	if (nullptr == record) {
+		return false;
+	}
+
+	std::memcpy(record, data, size);
+	m_impl->Commit(size);
+	return true;
+}
+
+bool SpillStore::Front(uint8_t const *&data, std::size_t &size) {
+	return m_impl->Front(data, size);
+}
+
+void SpillStore::PopFront() {
+	m_impl->PopFront();
+}
+
+void SpillStore::Clear() {
+	m_impl->Clear();
+}
+
+} // namespace basic
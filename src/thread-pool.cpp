@@ -7,8 +7,70 @@
 
 namespace basic {
 
-ThreadPool::ThreadPool(std::string name, uint16_t capacity)
-		: m_name(std::move(name)), m_capacity(capacity), m_isRunning(false) {
+//! Work stealing worker
+struct ThreadPool::Worker {
+	Worker(ThreadPool *pool, std::size_t index)
+			: m_pool(pool), m_index(index), m_seed(uint32_t(index) * 2654435761U + 1U) {}
+
+	//! Next victim candidate (xorshift)
+	std::size_t nextRandom() {
+		m_seed ^= m_seed << 13U;
+		m_seed ^= m_seed >> 17U;
+		m_seed ^= m_seed << 5U;
+		return m_seed;
+	}
+
+	//! Deque node
+	struct Node {
+		Task task;                                      //!< Task
+		std::chrono::steady_clock::time_point enqueued; //!< Time of push of a timed task
+	};
+
+	~Worker() {
+		for (Node *node : m_spare) {
+			delete node;
+		}
+	}
+
+	//! Wrap a task into a deque node, reusing spare nodes
+	Node *acquire(Task &&task, std::chrono::steady_clock::time_point enqueued) {
+		if (m_spare.empty()) {
+			return new Node{std::move(task), enqueued};
+		}
+		Node *const node = m_spare.back();
+		m_spare.pop_back();
+		node->task = std::move(task);
+		node->enqueued = enqueued;
+		return node;
+	}
+
+	//! Keep an emptied deque node for reuse (nodes migrate to the workers which steal them)
+	void release(Node *node) {
+		if (m_spare.size() < kMaxSpare) {
+			m_spare.push_back(node);
+		} else {
+			delete node;
+		}
+	}
+
+	static constexpr std::size_t kMaxSpare = 1024U;
+
+	ThreadPool *const m_pool;           //!< Owning pool
+	std::size_t const m_index;          //!< Index in ThreadPool::m_workers
+	uint32_t m_seed;                    //!< State of the victim selection
+	WorkStealingDeque<Node> m_deque;    //!< Tasks spawned by this worker
+	std::vector<Node *> m_spare;        //!< Emptied deque nodes
+};
+
+//! Constructor
+//!
+//! \param name - Name of the thread pool
+//! \param capacity - Maximum number of pending tasks (0 means unlimited)
+//! \param strategy - How idle workers wait for tasks
+//! \param scheduling - How tasks are distributed over the workers
+ThreadPool::ThreadPool(std::string name, uint16_t capacity, WaitStrategy strategy, Scheduling scheduling)
+		: m_name(std::move(name)), m_capacity(capacity), m_isRunning(false), m_waitStrategy(strategy),
+		  m_scheduling(scheduling) {
 
 }
 
@@ -18,13 +80,77 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::Start(unsigned int num_thread = std::thread::hardware_concurrency()) {
+	Elasticity elasticity;
+	elasticity.minThreads = elasticity.maxThreads = num_thread;
+	Start(elasticity);
+}
+
+void ThreadPool::Start(Elasticity const &elasticity) {
 	assert(m_threads.empty());
+	m_elasticity = elasticity;
+	m_elasticity.maxThreads = std::max(m_elasticity.maxThreads, m_elasticity.minThreads);
+	if (0 == m_elasticity.maxThreads) {
+		// nothing to start, Run() keeps running tasks inline
+		return;
+	}
+
+	std::lock_guard<std::mutex> lk(m_mutex);
 	m_isRunning = true;
-	m_threads.reserve(num_thread);
-	for (unsigned int i = 0; i < num_thread; ++i) {
-		m_threads.emplace_back(new basic::Thread([this] { runInThread(); }));
-		m_threads[i]->Start();
+	m_stats.Configure(m_metricsMode, m_sampleInterval, m_elasticity.maxThreads);
+	m_threads.resize(m_elasticity.maxThreads);
+	for (std::size_t slot = m_elasticity.maxThreads; slot > 0; --slot) {
+		m_freeSlots.push_back(slot - 1);
 	}
+	if (Scheduling::kWorkStealing == m_scheduling) {
+		// all deques exist before the first worker looks for a victim
+		m_workers.reserve(m_elasticity.maxThreads);
+		for (unsigned int i = 0; i < m_elasticity.maxThreads; ++i) {
+			m_workers.emplace_back(new Worker(this, i));
+		}
+	}
+	for (unsigned int i = 0; i < m_elasticity.minThreads; ++i) {
+		spawn();
+	}
+	m_lastProgress = m_lastGrow = std::chrono::steady_clock::now();
+}
+
+void ThreadPool::setAffinity(std::vector<CpuSet> affinity) {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	m_affinity = std::move(affinity);
+}
+
+std::size_t ThreadPool::getUnpinnedCount() const {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	std::size_t count = 0;
+	for (auto const &thread : m_threads) {
+		if (thread && thread->hasAffinityFailed()) {
+			++count;
+		}
+	}
+	return count;
+}
+
+void ThreadPool::setAging(std::chrono::milliseconds interval) {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	m_tasks.setAging(interval);
+}
+
+void ThreadPool::setMetrics(MetricsMode mode, std::size_t sampleInterval) {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	m_metricsMode = mode;
+	m_sampleInterval = sampleInterval;
+}
+
+PoolStatsSnapshot ThreadPool::getStats() const {
+	std::size_t depth = m_pending.load(std::memory_order_relaxed);
+	for (auto const &worker : m_workers) {
+		depth += worker->m_deque.Size();
+	}
+	return m_stats.Snapshot(depth);
+}
+
+void ThreadPool::ResetStats() {
+	m_stats.Reset();
 }
 
 void ThreadPool::Stop() {
@@ -32,37 +158,152 @@ void ThreadPool::Stop() {
 		std::lock_guard<std::mutex> lk(m_mutex);
 		m_isRunning = false;
 		m_condPush.notify_all();
+		m_condPop.notify_all();
 	}
+	m_idle.UnparkAll();
 
+	// no worker is added any more, retired ones are joined here as well
 	for (auto &thread : m_threads) {
-		thread->Join();
+		if (thread) {
+			thread->Join();
+		}
+	}
+
+	// tasks left are dropped, which breaks the promises they hold; they are destroyed without the
+	// lock, as the futures of the promises hand their continuations to Run()
+	std::vector<Task> dropped;
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		while (!m_tasks.empty()) {
+			dropped.push_back(m_tasks.pop());
+		}
+		m_pending.store(0, std::memory_order_relaxed);
+		m_urgent.store(false, std::memory_order_relaxed);
+	}
+	for (auto &worker : m_workers) {
+		while (Worker::Node *node = worker->m_deque.Pop()) {
+			dropped.push_back(std::move(node->task));
+			delete node;
+		}
 	}
 }
 
 void ThreadPool::Run(Task task) {
+	Run(std::move(task), TaskPriority::kNormal, detail::TaskQueue::kNoDeadline);
+}
+
+void ThreadPool::Run(Task task, TaskPriority priority) {
+	Run(std::move(task), priority, detail::TaskQueue::kNoDeadline);
+}
+
+void ThreadPool::Run(Task task, TaskPriority priority, std::chrono::steady_clock::time_point deadline) {
 	if (m_threads.empty()) {
 		task();
-	} else {
+		return;
+	}
+
+	Worker *const worker = (Scheduling::kWorkStealing == m_scheduling) ? currentWorker() : nullptr;
+	bool const own = nullptr != worker && this == worker->m_pool;
+	bool const timed = m_stats.isTimed();
+	if (own && TaskPriority::kNormal == priority && detail::TaskQueue::kNoDeadline == deadline) {
+		if (m_stats.isEnabled()) {
+			m_stats.getWorker(worker->m_index).onSpawn();
+		}
+		worker->m_deque.Push(worker->acquire(std::move(task),
+		                                     timed ? std::chrono::steady_clock::now()
+		                                           : std::chrono::steady_clock::time_point()));
+		m_idle.Unpark();
+		if (0 == m_waiting.load(std::memory_order_relaxed) &&
+		    m_live.load(std::memory_order_relaxed) < m_elasticity.maxThreads &&
+		    worker->m_deque.Size() >= m_elasticity.growDepth) {
+			std::lock_guard<std::mutex> lk(m_mutex);
+			grow();
+		}
+		return;
+	}
+
+	// a worker of this pool waiting for room in the queue could wait for itself
+	bool const member = this == currentPool();
+	{
 		std::unique_lock<std::mutex> lk(m_mutex);
-		while (m_capacity > 0 && m_tasks.size() >= m_capacity) {
+		while (m_isRunning && !member && m_capacity > 0 && m_tasks.size() >= m_capacity) {
 			m_condPop.wait(lk);
 		}
+		if (!m_isRunning) {
+			// a stopped pool drops the task like the ones it left queued, see Stop()
+			lk.unlock();
+			task = nullptr;
+			return;
+		}
 
-		m_tasks.push_back(std::move(task));
+		if (m_tasks.empty() && isElastic()) {
+			m_lastProgress = std::chrono::steady_clock::now();
+		}
+		pushBack(std::move(task), priority, deadline, timed);
 		m_condPush.notify_one();
+		grow();
+	}
+
+	if (Scheduling::kWorkStealing == m_scheduling) {
+		m_idle.Unpark();
 	}
 }
 
-ThreadPool::Task ThreadPool::take() {
+bool ThreadPool::take(std::size_t slot, Task &task, std::chrono::steady_clock::time_point &enqueued) {
+	if (0 == m_pending.load(std::memory_order_relaxed)) {
+		markIdle(slot);
+	}
+	if (WaitStrategy::kBlock != m_waitStrategy) {
+		spinWait(m_waitStrategy, [this] {
+			return 0 != m_pending.load(std::memory_order_relaxed) || !m_isRunning.load(std::memory_order_relaxed);
+		});
+	}
+
 	std::unique_lock<std::mutex> lk(m_mutex);
-	while (m_tasks.empty() && m_isRunning) {
-		m_condPush.wait(lk);
+	if (isParking(m_waitStrategy) && m_tasks.empty() && m_isRunning) {
+		auto const deadline = std::chrono::steady_clock::now() + m_elasticity.keepAlive;
+		m_waiting.fetch_add(1, std::memory_order_relaxed);
+		while (m_tasks.empty() && m_isRunning) {
+			if (!isElastic()) {
+				m_condPush.wait(lk);
+			} else if (std::cv_status::timeout == m_condPush.wait_until(lk, deadline) &&
+			           m_tasks.empty() && retire(slot)) {
+				m_waiting.fetch_sub(1, std::memory_order_relaxed);
+				return false;
+			}
+		}
+		m_waiting.fetch_sub(1, std::memory_order_relaxed);
 	}
 
+	// spinning workers which lost the race return an empty task and spin again
+	task = popFront(&enqueued);
+	grow();
+	return true;
+}
+
+void ThreadPool::pushBack(Task &&task, TaskPriority priority, std::chrono::steady_clock::time_point deadline,
+                          bool timed) {
+	if (m_tasks.isAging() || timed) {
+		m_tasks.push(std::move(task), priority, deadline, std::chrono::steady_clock::now(), timed);
+	} else {
+		m_tasks.push(std::move(task), priority, deadline);
+	}
+	m_pending.store(m_tasks.size(), std::memory_order_relaxed);
+	if (m_stats.isEnabled()) {
+		m_stats.onSubmit(m_tasks.size());
+	}
+	m_urgent.store(m_tasks.getHighest() > TaskPriority::kNormal, std::memory_order_relaxed);
+}
+
+ThreadPool::Task ThreadPool::popFront(std::chrono::steady_clock::time_point *enqueued) {
 	Task task;
 	if (! m_tasks.empty()) {
-		task = m_tasks.front();
-		m_tasks.pop_front();
+		task = m_tasks.isAging() ? m_tasks.pop(std::chrono::steady_clock::now(), enqueued) : m_tasks.pop({}, enqueued);
+		m_pending.store(m_tasks.size(), std::memory_order_relaxed);
+		m_urgent.store(!m_tasks.empty() && m_tasks.getHighest() > TaskPriority::kNormal, std::memory_order_relaxed);
+		if (isElastic()) {
+			m_lastProgress = std::chrono::steady_clock::now();
+		}
 		if (m_capacity > 0) {
 			m_condPop.notify_one();
 		}
@@ -71,17 +312,221 @@ ThreadPool::Task ThreadPool::take() {
 	return task;
 }
 
-void ThreadPool::runInThread() {
+void ThreadPool::runInThread(std::size_t slot) {
+	currentPool() = this;
+	if (m_stats.isEnabled()) {
+		m_stats.getWorker(slot).onStart(std::chrono::steady_clock::now());
+	}
+
+	Task task;
+	std::chrono::steady_clock::time_point enqueued;
+	while (m_isRunning && take(slot, task, enqueued)) {
+		if (task) {
+			runTask(slot, task, enqueued);
+			task = nullptr;
+			enqueued = {};
+		}
+	}
+
+	if (m_stats.isEnabled()) {
+		m_stats.getWorker(slot).onStop(std::chrono::steady_clock::now());
+	}
+	currentPool() = nullptr;
+}
+
+void ThreadPool::runTask(std::size_t slot, Task &task, std::chrono::steady_clock::time_point enqueued) {
+	if (!m_stats.isEnabled()) {
+		task();
+		return;
+	}
+
+	detail::WorkerStats &stats = m_stats.getWorker(slot);
+	if (std::chrono::steady_clock::time_point() == enqueued) {
+		if (stats.isIdle()) {
+			stats.onBusy(std::chrono::steady_clock::now());
+		}
+		task();
+	} else {
+		auto const start = std::chrono::steady_clock::now();
+		stats.onBusy(start);
+		task();
+		m_stats.onTimed(start - enqueued, std::chrono::steady_clock::now() - start);
+	}
+	stats.onTask();
+}
+
+void ThreadPool::markIdle(std::size_t slot) {
+	if (m_stats.isEnabled() && !m_stats.getWorker(slot).isIdle()) {
+		m_stats.getWorker(slot).onIdle(std::chrono::steady_clock::now());
+	}
+}
+
+void ThreadPool::grow() {
+	if (!m_isRunning || m_live.load(std::memory_order_relaxed) >= m_elasticity.maxThreads) {
+		return;
+	}
+
+	auto const now = std::chrono::steady_clock::now();
+	if (0 != m_live.load(std::memory_order_relaxed)) {
+		if (now - m_lastGrow < m_elasticity.growInterval) {
+			return;
+		}
+		bool const deep = 0 == m_waiting.load(std::memory_order_relaxed) && m_tasks.size() >= m_elasticity.growDepth;
+		bool const stalled = !m_tasks.empty() && now - m_lastProgress >= m_elasticity.growWait;
+		if (!deep && !stalled) {
+			return;
+		}
+	}
+
+	m_lastGrow = now;
+	spawn();
+}
+
+bool ThreadPool::isElastic() const {
+	return m_elasticity.minThreads != m_elasticity.maxThreads;
+}
+
+bool ThreadPool::retire(std::size_t slot) {
+	if (!m_isRunning || m_live.load(std::memory_order_relaxed) <= m_elasticity.minThreads) {
+		return false;
+	}
+
+	// the thread is joined when its slot is reused or the pool stops
+	m_live.fetch_sub(1, std::memory_order_relaxed);
+	m_freeSlots.push_back(slot);
+	return true;
+}
+
+void ThreadPool::spawn() {
+	std::size_t const slot = m_freeSlots.back();
+	m_freeSlots.pop_back();
+
+	std::unique_ptr<basic::Thread> &thread = m_threads[slot];
+	if (thread) {
+		// retired thread, it is done with the pool once it gave back its slot
+		thread->Join();
+	}
+	if (Scheduling::kWorkStealing == m_scheduling) {
+		thread.reset(new basic::Thread([this, slot] { runWorker(*m_workers[slot]); }));
+	} else {
+		thread.reset(new basic::Thread([this, slot] { runInThread(slot); }));
+	}
+	if (!m_affinity.empty()) {
+		thread->setAffinity(m_affinity[slot % m_affinity.size()]);
+	}
+	m_live.fetch_add(1, std::memory_order_relaxed);
+	thread->Start();
+}
+
+ThreadPool::Task ThreadPool::findTask(Worker &worker, std::chrono::steady_clock::time_point &enqueued) {
+	// queued tasks above normal priority first, then own tasks, newest first while their data is still in the cache
+	Worker::Node *node = nullptr;
+	if (!m_urgent.load(std::memory_order_relaxed)) {
+		node = worker.m_deque.Pop();
+	}
+
+	if (nullptr == node && 0 != m_pending.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		Task task(popFront(&enqueued));
+		grow();
+		if (task) {
+			return task;
+		}
+	}
+
+	// oldest task of a random victim, likely the root of a larger piece of work
+	std::size_t const count = m_workers.size();
+	std::size_t const first = worker.nextRandom();
+	for (std::size_t i = 0; nullptr == node && i < count; ++i) {
+		Worker &victim = *m_workers[(first + i) % count];
+		if (&victim != &worker) {
+			node = victim.m_deque.Steal();
+		}
+	}
+
+	Task task;
+	if (nullptr != node) {
+		task = std::move(node->task);
+		enqueued = node->enqueued;
+		worker.release(node);
+	}
+	return task;
+}
+
+bool ThreadPool::hasTasks() const {
+	if (0 != m_pending.load(std::memory_order_relaxed)) {
+		return true;
+	}
+	for (auto const &worker : m_workers) {
+		if (!worker->m_deque.isEmpty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::runWorker(Worker &worker) {
+	currentWorker() = &worker;
+	currentPool() = this;
+	if (m_stats.isEnabled()) {
+		m_stats.getWorker(worker.m_index).onStart(std::chrono::steady_clock::now());
+	}
+
+	auto const ready = [this] {
+		return hasTasks() || !m_isRunning.load(std::memory_order_relaxed);
+	};
+	bool const elastic = isElastic();
 	while (m_isRunning) {
-		Task task(take());
+		std::chrono::steady_clock::time_point enqueued;
+		Task task(findTask(worker, enqueued));
 		if (task) {
-			task();
+			runTask(worker.m_index, task, enqueued);
+			continue;
+		}
+		markIdle(worker.m_index);
+		if (!spinWait(m_waitStrategy, ready)) {
+			m_waiting.fetch_add(1, std::memory_order_relaxed);
+			if (!elastic) {
+				m_idle.Park(ready);
+			} else if (!m_idle.ParkUntil(ready, std::chrono::steady_clock::now() + m_elasticity.keepAlive)) {
+				// only this worker pushes to its deque, so it is empty for good once the worker is gone
+				std::lock_guard<std::mutex> lk(m_mutex);
+				if (!hasTasks() && retire(worker.m_index)) {
+					m_waiting.fetch_sub(1, std::memory_order_relaxed);
+					break;
+				}
+			}
+			m_waiting.fetch_sub(1, std::memory_order_relaxed);
 		}
 	}
+
+	if (m_stats.isEnabled()) {
+		m_stats.getWorker(worker.m_index).onStop(std::chrono::steady_clock::now());
+	}
+	currentPool() = nullptr;
+	currentWorker() = nullptr;
+}
+
+ThreadPool::Worker *&ThreadPool::currentWorker() {
+	static thread_local Worker *s_worker = nullptr;
+	return s_worker;
+}
+
+ThreadPool *&ThreadPool::currentPool() {
+	static thread_local ThreadPool *s_pool = nullptr;
+	return s_pool;
+}
+
+void ThreadPool::Execute(Task task) {
+	Run(std::move(task));
 }
 
 const std::string &ThreadPool::Name() const {
 	return m_name;
 }
 
-} // namespace basic
\ No newline at end of file
+std::size_t ThreadPool::getThreadCount() const {
+	return m_live.load(std::memory_order_relaxed);
+}
+
+} // namespace basic
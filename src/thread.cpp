@@ -4,6 +4,7 @@
 #include <cassert>
 
 #include "thread.h"
+#include "logging.h"
 
 namespace basic {
 
@@ -12,7 +13,8 @@ Thread::Thread(Function func)
 
 Thread::Thread(Thread &&rhs) noexcept
 		: m_isJoined(rhs.m_isJoined), m_isStarted(rhs.m_isStarted), m_thread(std::move(rhs.m_thread)),
-		  m_func(std::move(rhs.m_func)) {
+		  m_func(std::move(rhs.m_func)), m_affinity(std::move(rhs.m_affinity)),
+		  m_affinityFailed(std::move(rhs.m_affinityFailed)) {
 
 }
 
@@ -22,6 +24,8 @@ Thread &Thread::operator=(Thread &&rhs) noexcept {
 		m_isStarted = rhs.m_isStarted;
 		m_thread = std::move(rhs.m_thread);
 		m_func = std::move(rhs.m_func);
+		m_affinity = std::move(rhs.m_affinity);
+		m_affinityFailed = std::move(rhs.m_affinityFailed);
 	}
 
 	return *this;
@@ -37,7 +41,27 @@ void Thread::Start() {
 	assert(!m_isStarted);
 	m_isStarted = true;
 
-	m_thread = std::thread(m_func);
+	if (m_affinity.isEmpty()) {
+		m_thread = std::thread(m_func);
+	} else {
+		// pin before the thread function runs, so that the memory it touches first is node local
+		m_affinityFailed = std::make_shared<std::atomic<bool> >(false);
+		m_thread = std::thread([func = m_func, affinity = m_affinity, failed = m_affinityFailed] {
+			if (!affinity.Apply()) {
+				failed->store(true, std::memory_order_relaxed);
+				LOG_WARN << "failed to pin thread to CPUs " << affinity.toString() << ", running unpinned";
+			}
+			func();
+		});
+	}
+}
+
+void Thread::setAffinity(CpuSet affinity) {
+	m_affinity = std::move(affinity);
+}
+
+bool Thread::hasAffinityFailed() const {
+	return m_affinityFailed && m_affinityFailed->load(std::memory_order_relaxed);
 }
 
 bool Thread::isStarted() const {
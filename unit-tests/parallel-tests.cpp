@@ -0,0 +1,34 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <atomic>
+#include <gtest/gtest.h>
+
+#include "parallel.h"
+#include "thread-pool.h"
+
+namespace {
+
+class ParallelTest : public testing::TestWithParam<basic::Scheduling> {
+};
+
+TEST_P(ParallelTest, NestedCallsOnBoundedPoolComplete) {
+	// two workers and room for one queued task: the inner calls are made by workers whose helpers
+	// find the queue full
+	basic::ThreadPool pool("ParallelPool", 1, basic::WaitStrategy::kBlock, GetParam());
+	pool.Start(2);
+
+	std::atomic<int> count{0};
+	basic::ParallelFor(pool, 0, 64, [&pool, &count](int) {
+		basic::ParallelFor(pool, 0, 64, [&count](int) { count.fetch_add(1, std::memory_order_relaxed); }, 1U);
+	}, 1U);
+	pool.Stop();
+
+	EXPECT_EQ(64 * 64, count.load());
+}
+
+INSTANTIATE_TEST_SUITE_P(Schedulings, ParallelTest,
+                         testing::Values(basic::Scheduling::kShared, basic::Scheduling::kWorkStealing));
+
+} // namespace
@@ -0,0 +1,77 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "shm-queue.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+class ShmQueueTest : public testing::TestWithParam<basic::WaitStrategy> {
+protected:
+	void SetUp() override {
+		m_name = "/basic-shm-queue-test-" + std::to_string(::getpid());
+		basic::ShmQueue<int>::Unlink(m_name.c_str());
+	}
+
+	void TearDown() override {
+		basic::ShmQueue<int>::Unlink(m_name.c_str());
+	}
+
+	std::string m_name;
+};
+
+TEST_P(ShmQueueTest, TimedPopTakesEveryValueOnce) {
+	basic::ShmQueue<int> queue(m_name.c_str(), 8, basic::ShmQueue<int>::Mode::kCreate, GetParam());
+	ASSERT_TRUE(queue);
+
+	queue.Push(1);
+	queue.Push(2);
+	queue.Push(3);
+
+	for (int expected = 1; expected <= 3; ++expected) {
+		int value = 0;
+		EXPECT_TRUE(queue.Pop(value, 100ms));
+		EXPECT_EQ(expected, value);
+	}
+	EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_P(ShmQueueTest, TimedPopTimesOutOnEmptyQueue) {
+	basic::ShmQueue<int> queue(m_name.c_str(), 8, basic::ShmQueue<int>::Mode::kCreate, GetParam());
+	ASSERT_TRUE(queue);
+
+	int value = -1;
+	auto const start = std::chrono::steady_clock::now();
+	EXPECT_FALSE(queue.Pop(value, 20ms));
+	EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+	EXPECT_EQ(-1, value);
+}
+
+TEST_P(ShmQueueTest, TimedPopWaitsForProducer) {
+	basic::ShmQueue<int> queue(m_name.c_str(), 8, basic::ShmQueue<int>::Mode::kCreate, GetParam());
+	ASSERT_TRUE(queue);
+
+	std::thread producer([&queue] {
+		std::this_thread::sleep_for(10ms);
+		queue.Push(42);
+	});
+	int value = 0;
+	EXPECT_TRUE(queue.Pop(value, 5s));
+	EXPECT_EQ(42, value);
+	producer.join();
+	EXPECT_TRUE(queue.isEmpty());
+}
+
+INSTANTIATE_TEST_SUITE_P(WaitStrategies, ShmQueueTest,
+                         testing::Values(basic::WaitStrategy::kBusySpin, basic::WaitStrategy::kSpinYield,
+                                         basic::WaitStrategy::kSpinPark, basic::WaitStrategy::kBlock));
+
+} // namespace
@@ -0,0 +1,84 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <chrono>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "task-queue.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+using basic::TaskPriority;
+using basic::detail::TaskQueue;
+
+//! Queue tasks which record their number, and pop them all
+class TaskQueueTest : public testing::Test {
+protected:
+	void push(int number, TaskPriority priority, TaskQueue::Clock::time_point deadline = TaskQueue::kNoDeadline,
+	          TaskQueue::Clock::time_point now = {}) {
+		m_queue.push([this, number] { m_order.push_back(number); }, priority, deadline, now);
+	}
+
+	std::vector<int> popAll(TaskQueue::Clock::time_point now = {}) {
+		while (!m_queue.empty()) {
+			m_queue.pop(now)();
+		}
+		return m_order;
+	}
+
+	TaskQueue m_queue;
+	std::vector<int> m_order;
+	TaskQueue::Clock::time_point const m_start = TaskQueue::Clock::now();
+};
+
+TEST_F(TaskQueueTest, HigherClassesFirst) {
+	push(0, TaskPriority::kLow);
+	push(1, TaskPriority::kNormal);
+	push(2, TaskPriority::kCritical);
+	push(3, TaskPriority::kHigh);
+	push(4, TaskPriority::kNormal);
+
+	EXPECT_EQ((std::vector<int>{2, 3, 1, 4, 0}), popAll());
+}
+
+TEST_F(TaskQueueTest, EarliestDeadlineFirstWithinClass) {
+	push(0, TaskPriority::kHigh);
+	push(1, TaskPriority::kHigh, m_start + 30ms);
+	push(2, TaskPriority::kHigh, m_start + 10ms);
+	push(3, TaskPriority::kHigh, m_start + 20ms);
+	push(4, TaskPriority::kHigh, m_start + 10ms);
+
+	// deadline tasks before the FIFO ones, ties in push order
+	EXPECT_EQ((std::vector<int>{2, 4, 3, 1, 0}), popAll());
+}
+
+TEST_F(TaskQueueTest, AgingLetsOldTasksOvertake) {
+	m_queue.setAging(10ms);
+	push(0, TaskPriority::kLow, TaskQueue::kNoDeadline, m_start);
+	push(1, TaskPriority::kCritical, TaskQueue::kNoDeadline, m_start + 20ms);
+	push(2, TaskPriority::kNormal, TaskQueue::kNoDeadline, m_start + 20ms);
+
+	// after 25ms the low task gained two classes, it passes the normal task but not the critical one
+	EXPECT_EQ((std::vector<int>{1, 0, 2}), popAll(m_start + 25ms));
+	m_order.clear();
+
+	// after 40ms it gained four classes and passes a fresh critical task
+	push(3, TaskPriority::kLow, TaskQueue::kNoDeadline, m_start);
+	push(4, TaskPriority::kCritical, TaskQueue::kNoDeadline, m_start + 40ms);
+	EXPECT_EQ((std::vector<int>{3, 4}), popAll(m_start + 40ms));
+}
+
+TEST_F(TaskQueueTest, AgingUsesOldestTaskOfLane) {
+	m_queue.setAging(10ms);
+	// the old FIFO task ages the low lane, although the young deadline task runs first within it
+	push(0, TaskPriority::kLow, TaskQueue::kNoDeadline, m_start);
+	push(1, TaskPriority::kLow, m_start + 100ms, m_start + 40ms);
+	push(2, TaskPriority::kCritical, TaskQueue::kNoDeadline, m_start + 40ms);
+
+	EXPECT_EQ((std::vector<int>{1, 0, 2}), popAll(m_start + 40ms));
+}
+
+} // namespace
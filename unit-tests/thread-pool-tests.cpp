@@ -0,0 +1,301 @@
+//
+// Created by liu on 17.10.2026.
+//
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "thread-pool.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr int kChildren = 64;
+
+//! Poll until ready() holds, false if it did not within the timeout
+template<typename Ready>
+bool waitFor(Ready &&ready, std::chrono::milliseconds timeout = 10s) {
+	auto const deadline = std::chrono::steady_clock::now() + timeout;
+	while (!ready()) {
+		if (std::chrono::steady_clock::now() >= deadline) {
+			return false;
+		}
+		std::this_thread::sleep_for(1ms);
+	}
+	return true;
+}
+
+//! Run a binary tree of tasks, every task spawns its children from the worker running it
+void spawnTree(basic::ThreadPool &pool, int depth, std::atomic<int> &done) {
+	if (depth > 0) {
+		pool.Run([&pool, depth, &done] { spawnTree(pool, depth - 1, done); });
+		pool.Run([&pool, depth, &done] { spawnTree(pool, depth - 1, done); });
+	}
+	done.fetch_add(1, std::memory_order_relaxed);
+}
+
+TEST(ThreadPoolWorkStealing, SpawnedTasksComplete) {
+	basic::ThreadPool pool("StealPool", 64, basic::WaitStrategy::kBlock, basic::Scheduling::kWorkStealing);
+	pool.Start(3);
+
+	std::atomic<int> done{0};
+	pool.Run([&pool, &done] { spawnTree(pool, 10, done); });
+
+	EXPECT_TRUE(waitFor([&done] { return (1 << 11) - 1 == done.load(); }));
+	pool.Stop();
+	EXPECT_EQ((1 << 11) - 1, done.load());
+}
+
+TEST(ThreadPoolWorkStealing, IdleWorkersStealSpawnedTasks) {
+	basic::ThreadPool pool("StealPool", 64, basic::WaitStrategy::kBlock, basic::Scheduling::kWorkStealing);
+	pool.Start(3);
+
+	std::mutex mutex;
+	std::set<std::thread::id> runners;
+	std::atomic<int> done{0};
+	std::promise<std::thread::id> root;
+
+	// the children go to the deque of the root's worker, which blocks until they are done, so only
+	// the other workers can run them by stealing
+	pool.Run([&] {
+		root.set_value(std::this_thread::get_id());
+		for (int i = 0; i < kChildren; ++i) {
+			pool.Run([&] {
+				{
+					std::lock_guard<std::mutex> lk(mutex);
+					runners.insert(std::this_thread::get_id());
+				}
+				done.fetch_add(1, std::memory_order_relaxed);
+			});
+		}
+		waitFor([&done] { return kChildren == done.load(); });
+	});
+
+	std::thread::id const rootId = root.get_future().get();
+	EXPECT_TRUE(waitFor([&done] { return kChildren == done.load(); }));
+	pool.Stop();
+
+	EXPECT_EQ(kChildren, done.load());
+	EXPECT_FALSE(runners.empty());
+	EXPECT_EQ(0U, runners.count(rootId));
+}
+
+TEST(ThreadPoolWorkStealing, StopDropsTasksLeftInDeques) {
+	basic::ThreadPool pool("StealPool", 64, basic::WaitStrategy::kBlock, basic::Scheduling::kWorkStealing);
+	pool.Start(1);
+
+	std::vector<basic::Future<int> > futures;
+	std::atomic<bool> spawned{false};
+	std::atomic<bool> stopping{false};
+
+	// the only worker fills its own deque and keeps running while the pool stops
+	pool.Run([&] {
+		for (int i = 0; i < kChildren; ++i) {
+			futures.push_back(pool.Submit([i] { return i; }));
+		}
+		spawned.store(true);
+		waitFor([&stopping] { return stopping.load(); });
+		std::this_thread::sleep_for(50ms);
+	});
+
+	ASSERT_TRUE(waitFor([&spawned] { return spawned.load(); }));
+	stopping.store(true);
+	pool.Stop();
+
+	// every future is complete once Stop() returned, with its value or with a broken promise
+	int completed = 0;
+	int broken = 0;
+	for (auto &future : futures) {
+		ASSERT_TRUE(future.isReady());
+		try {
+			future.Get();
+			++completed;
+		} catch (std::future_error const &error) {
+			EXPECT_EQ(std::make_error_code(std::future_errc::broken_promise), error.code());
+			++broken;
+		}
+	}
+	EXPECT_EQ(kChildren, completed + broken);
+}
+
+class ThreadPoolPriorityTest : public testing::TestWithParam<basic::Scheduling> {
+};
+
+TEST_P(ThreadPoolPriorityTest, HeldBackTasksRunByClassAndDeadline) {
+	basic::ThreadPool pool("PriorityPool", 64, basic::WaitStrategy::kBlock, GetParam());
+	pool.Start(1);
+
+	// the only worker is held while the tasks queue up
+	std::atomic<bool> started{false};
+	std::atomic<bool> release{false};
+	pool.Run([&started, &release] {
+		started.store(true);
+		waitFor([&release] { return release.load(); });
+	});
+	ASSERT_TRUE(waitFor([&started] { return started.load(); }));
+
+	std::mutex mutex;
+	std::vector<int> order;
+	auto const record = [&mutex, &order](int number) {
+		return [&mutex, &order, number] {
+			std::lock_guard<std::mutex> lk(mutex);
+			order.push_back(number);
+		};
+	};
+	auto const now = std::chrono::steady_clock::now();
+	pool.Run(record(0), basic::TaskPriority::kLow);
+	pool.Run(record(1), basic::TaskPriority::kNormal);
+	pool.Run(record(2), basic::TaskPriority::kCritical);
+	pool.Run(record(3), basic::TaskPriority::kHigh, now + 20s);
+	pool.Run(record(4), basic::TaskPriority::kHigh, now + 10s);
+	pool.Run(record(5), basic::TaskPriority::kHigh);
+
+	release.store(true);
+	EXPECT_TRUE(waitFor([&mutex, &order] {
+		std::lock_guard<std::mutex> lk(mutex);
+		return 6U == order.size();
+	}));
+	pool.Stop();
+
+	// critical, high by deadline then without one, normal, low
+	EXPECT_EQ((std::vector<int>{2, 4, 3, 5, 1, 0}), order);
+}
+
+INSTANTIATE_TEST_SUITE_P(Schedulings, ThreadPoolPriorityTest,
+                         testing::Values(basic::Scheduling::kShared, basic::Scheduling::kWorkStealing));
+
+class ThreadPoolStatsTest : public testing::TestWithParam<basic::Scheduling> {
+};
+
+TEST_P(ThreadPoolStatsTest, CountsSubmittedAndCompletedTasks) {
+	basic::ThreadPool pool("StatsPool", 1024, basic::WaitStrategy::kBlock, GetParam());
+	pool.setMetrics(basic::MetricsMode::kFull);
+	pool.Start(2);
+
+	// every task runs a child from its worker, which counts as submitted too
+	constexpr uint64_t kTasks = 500U;
+	for (uint64_t i = 0U; i < kTasks; ++i) {
+		pool.Run([&pool] { pool.Run([] {}); });
+	}
+	EXPECT_TRUE(waitFor([&pool] { return 2U * kTasks == pool.getStats().completed; }));
+
+	basic::PoolStatsSnapshot const stats = pool.getStats();
+	pool.Stop();
+
+	EXPECT_EQ(2U * kTasks, stats.submitted);
+	EXPECT_EQ(2U * kTasks, stats.completed);
+	EXPECT_EQ(0U, stats.queueDepth);
+	EXPECT_EQ(2U * kTasks, stats.queueWait.Count());
+	EXPECT_EQ(2U * kTasks, stats.runTime.Count());
+	uint64_t perWorker = 0U;
+	for (auto const &worker : stats.workers) {
+		perWorker += worker.tasks;
+	}
+	EXPECT_EQ(stats.completed, perWorker);
+}
+
+TEST_P(ThreadPoolStatsTest, ResetDuringRunNeverWraps) {
+	basic::ThreadPool pool("StatsPool", 1024, basic::WaitStrategy::kBlock, GetParam());
+	pool.setMetrics(basic::MetricsMode::kSampled, 8U);
+	pool.Start(2);
+
+	constexpr uint64_t kTasks = 20000U;
+	std::atomic<uint64_t> pushed{0U};
+	std::atomic<uint64_t> done{0U};
+	std::atomic<bool> running{true};
+	std::atomic<int> violations{0};
+	std::thread resetter([&] {
+		while (running.load()) {
+			uint64_t const pushedBefore = pushed.load();
+			uint64_t const doneBefore = done.load();
+			pool.ResetStats();
+			basic::PoolStatsSnapshot const stats = pool.getStats();
+
+			// counted since the reset: what ran or was pushed meanwhile, plus one in flight per thread
+			uint64_t const maxSubmitted = pushed.load() - pushedBefore + 1U;
+			uint64_t const maxCompleted = done.load() - doneBefore + stats.workers.size();
+			bool sane = stats.submitted <= maxSubmitted && stats.completed <= maxCompleted &&
+			            stats.elapsed.count() >= 0;
+			for (auto const &worker : stats.workers) {
+				sane = sane && worker.tasks <= maxCompleted && worker.busy.count() >= 0 && worker.idle.count() >= 0;
+			}
+			violations.fetch_add(sane ? 0 : 1);
+		}
+	});
+
+	for (uint64_t i = 0U; i < kTasks; ++i) {
+		pushed.fetch_add(1U);
+		pool.Run([&done] { done.fetch_add(1U); });
+	}
+	EXPECT_TRUE(waitFor([&done] { return kTasks == done.load(); }));
+	running.store(false);
+	resetter.join();
+
+	// once the workers are joined a reset clears everything
+	pool.Stop();
+	pool.ResetStats();
+	basic::PoolStatsSnapshot const cleared = pool.getStats();
+
+	EXPECT_EQ(0, violations.load());
+	EXPECT_EQ(0U, cleared.completed);
+	EXPECT_EQ(0U, cleared.submitted);
+	for (auto const &worker : cleared.workers) {
+		EXPECT_EQ(0U, worker.tasks);
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(Schedulings, ThreadPoolStatsTest,
+                         testing::Values(basic::Scheduling::kShared, basic::Scheduling::kWorkStealing));
+
+class ThreadPoolElasticTest : public testing::TestWithParam<basic::Scheduling> {
+};
+
+TEST_P(ThreadPoolElasticTest, GrowsUnderBurstAndRetiresAfterKeepAlive) {
+	basic::ThreadPool::Elasticity elasticity;
+	elasticity.minThreads = 1U;
+	elasticity.maxThreads = 4U;
+	elasticity.keepAlive = 50ms;
+	elasticity.growDepth = 2U;
+	elasticity.growWait = 10ms;
+	elasticity.growInterval = 1ms;
+
+	basic::ThreadPool pool("ElasticPool", 64, basic::WaitStrategy::kBlock, GetParam());
+	pool.Start(elasticity);
+	EXPECT_EQ(1U, pool.getThreadCount());
+
+	// the second burst reuses the slots of the workers retired after the first one
+	for (int round = 0; round < 2; ++round) {
+		std::atomic<bool> release{false};
+		std::atomic<int> started{0};
+		std::atomic<int> done{0};
+
+		// tasks which hold their worker pile up until the pool reached its maximum
+		while (pool.getThreadCount() < elasticity.maxThreads && started.load() < 60) {
+			started.fetch_add(1);
+			pool.Run([&release, &done] {
+				waitFor([&release] { return release.load(); });
+				done.fetch_add(1);
+			});
+			std::this_thread::sleep_for(2ms);
+		}
+		EXPECT_EQ(elasticity.maxThreads, pool.getThreadCount()) << "round " << round;
+
+		release.store(true);
+		EXPECT_TRUE(waitFor([&done, &started] { return started.load() == done.load(); })) << "round " << round;
+		EXPECT_TRUE(waitFor([&pool, &elasticity] { return elasticity.minThreads == pool.getThreadCount(); }))
+			<< "round " << round;
+	}
+	pool.Stop();
+}
+
+INSTANTIATE_TEST_SUITE_P(Schedulings, ThreadPoolElasticTest,
+                         testing::Values(basic::Scheduling::kShared, basic::Scheduling::kWorkStealing));
+
+} // namespace